@@ -317,10 +317,15 @@ const char WEB_UI[] PROGMEM = R"rawliteral(
   <script>
     let socket = null;
     const relayStates = [];
+    let bootId = null;
+    let lastVersion = null;
+    let nextCommandId = Math.floor(Math.random() * 1000000000);
 
     function connectWebSocket() {
-      // Connect to WebSocket on port 81 (ESP8266 WebSocket default port)
-      socket = new WebSocket('ws://' + window.location.hostname + ':81');
+      // Connect to WebSocket on port 81 (ESP8266 WebSocket default port),
+      // resuming from the last state we saw so only missed changes are sent
+      const resume = bootId !== null ? `/?boot=${bootId}&version=${lastVersion}` : '/';
+      socket = new WebSocket('ws://' + window.location.hostname + ':81' + resume);
       
       socket.onopen = () => {
         document.getElementById('connectionStatus').className = 'connection-status connection-online';
@@ -344,10 +349,26 @@ const char WEB_UI[] PROGMEM = R"rawliteral(
           const data = JSON.parse(event.data);
           console.log('Received:', data);
           
+          if (data.version !== undefined) {
+            lastVersion = data.version;
+          }
+          
           if (data.type === 'relay') {
             updateRelayState(data.index, data.state);
+          } else if (data.type === 'relays') {
+            data.states.forEach((state, index) => updateRelayState(index, state));
           } else if (data.type === 'sensor') {
             updateSensorReading(data);
+          } else if (data.type === 'sensors') {
+            data.sensors.forEach(updateSensorReading);
+          } else if (data.type === 'snapshot') {
+            bootId = data.boot;
+            data.relays.forEach((state, index) => updateRelayState(index, state));
+            data.sensors.forEach(updateSensorReading);
+          } else if (data.type === 'delta') {
+            data.relays.forEach((relay) => updateRelayState(relay.index, relay.state));
+          } else if (data.type === 'nack') {
+            console.warn('Command rejected:', data.id);
           }
         } catch (e) {
           console.error('Error processing message:', e);
@@ -372,6 +393,7 @@ const char WEB_UI[] PROGMEM = R"rawliteral(
 
       const message = {
         type: 'relay',
+        id: nextCommandId++,
         index: index,
         state: !relayStates[index]
       };
@@ -583,6 +605,35 @@ const char SETUP_UI[] PROGMEM = R"rawliteral(
             }
 
             html += `<input type="number" name="sensor${index}_pin" placeholder="GPIO Pin" required>
+                <input type="number" name="sensor${index}_deadband" placeholder="Deadband (0.1 units or %)" min="0" max="255">
+                <select name="sensor${index}_deadbandMode">
+                    <option value="0">Absolute</option>
+                    <option value="1">Percent</option>
+                </select>
+                <input type="number" name="sensor${index}_maxSilence" placeholder="Heartbeat (s)" min="1" max="255">`;
+
+            if (type !== "1") {
+                html += `<select name="sensor${index}_oversample">
+                    <option value="0">1 read</option>
+                    <option value="1">4 reads</option>
+                    <option value="2" selected>16 reads</option>
+                    <option value="3">64 reads</option>
+                </select>
+                <select name="sensor${index}_median">
+                    <option value="0">No median</option>
+                    <option value="1" selected>Median of 3</option>
+                    <option value="2">Median of 5</option>
+                </select>
+                <select name="sensor${index}_smoothing">
+                    <option value="0">No smoothing</option>
+                    <option value="1">Smoothing 1/2</option>
+                    <option value="2" selected>Smoothing 1/4</option>
+                    <option value="3">Smoothing 1/8</option>
+                    <option value="4">Smoothing 1/16</option>
+                </select>`;
+            }
+
+            html += `
                 <button type="button" onclick="this.parentElement.remove()">Remove</button>
             </div>`;
 
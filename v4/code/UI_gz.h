@@ -0,0 +1,305 @@
+// UI_gz.h
+// Generated by tools/build_ui.py from UI.h - do not edit
+#ifndef UI_GZ_H
+#define UI_GZ_H
+
+#include <Arduino.h>
+
+#define WEB_UI_GZ_ETAG "\"c4425fd978e1e51b\""
+const uint8_t WEB_UI_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x5a, 0x7b, 0x53, 0xe3, 0x46,
+    0x12, 0xff, 0xdf, 0x9f, 0x62, 0x96, 0xdb, 0x9c, 0xe4, 0xc5, 0x96, 0x1f, 0x3c, 0x42, 0x6c, 0x60,
+    0x93, 0x70, 0x6c, 0x25, 0x57, 0xc9, 0xb2, 0xb5, 0x6c, 0xdd, 0xd5, 0x55, 0x2a, 0x55, 0x8c, 0xad,
+    0xb1, 0xad, 0xac, 0xa4, 0x51, 0x49, 0x63, 0x0c, 0x47, 0xfc, 0x9d, 0xee, 0x33, 0xdc, 0x27, 0xbb,
+    0xee, 0x9e, 0x91, 0x34, 0x7a, 0x18, 0x08, 0x49, 0x0e, 0x16, 0x24, 0xcf, 0xa3, 0x5f, 0xd3, 0xfd,
+    0xeb, 0xee, 0x61, 0x4f, 0x5f, 0xfd, 0xed, 0xea, 0xe2, 0xd3, 0xbf, 0x3e, 0x5c, 0xb2, 0x95, 0x8a,
+    0xc2, 0xf3, 0xce, 0x69, 0xfe, 0x10, 0xdc, 0x87, 0x87, 0x0a, 0x54, 0x28, 0xce, 0x3f, 0x8a, 0x90,
+    0xdf, 0xb3, 0x0b, 0x19, 0xab, 0x54, 0x86, 0xa7, 0x03, 0x3d, 0xd8, 0x39, 0x8d, 0x84, 0xe2, 0x2c,
+    0xe6, 0x91, 0x38, 0xdb, 0xbb, 0x0d, 0xc4, 0x26, 0x91, 0xa9, 0xda, 0x63, 0x73, 0x58, 0x25, 0x62,
+    0x75, 0xb6, 0xb7, 0x09, 0x7c, 0xb5, 0x3a, 0xf3, 0xc5, 0x6d, 0x30, 0x17, 0x7d, 0xfa, 0xd0, 0x63,
+    0x41, 0x1c, 0xa8, 0x80, 0x87, 0xfd, 0x6c, 0xce, 0x43, 0x71, 0x36, 0xf2, 0x86, 0x7b, 0x40, 0x26,
+    0x53, 0xf7, 0x48, 0x6e, 0x92, 0x4a, 0xa9, 0xd8, 0x43, 0xa7, 0xdf, 0x4f, 0xd2, 0x20, 0xe2, 0xe9,
+    0x7d, 0x7f, 0x2e, 0x43, 0x99, 0x4e, 0xd8, 0x5f, 0x86, 0xe3, 0x93, 0x13, 0x7f, 0x34, 0x85, 0x99,
+    0x6c, 0x3d, 0x9f, 0x8b, 0x2c, 0x2b, 0x66, 0x0e, 0xe7, 0x7c, 0x71, 0x34, 0xc4, 0x19, 0x9f, 0xc7,
+    0x4b, 0x91, 0x16, 0x13, 0x8b, 0xc3, 0xc3, 0x83, 0x83, 0x63, 0x9c, 0x98, 0xf1, 0xf9, 0xe7, 0x65,
+    0x2a, 0xd7, 0xb1, 0x5f, 0x4c, 0x8e, 0xc6, 0xf8, 0x8d, 0x93, 0x73, 0x9e, 0xfa, 0xd6, 0x0a, 0x9c,
+    0x13, 0xf8, 0x8d, 0x73, 0x4a, 0xdc, 0xa9, 0x5c, 0x14, 0xa4, 0x48, 0x5f, 0xc5, 0x44, 0x26, 0x40,
+    0x51, 0x5f, 0x4f, 0x9d, 0xd0, 0xd7, 0xb4, 0xb3, 0xed, 0xbc, 0x01, 0xf9, 0x61, 0xfd, 0x32, 0x88,
+    0x27, 0x0c, 0xc4, 0x4a, 0xb8, 0xef, 0x07, 0xf1, 0x92, 0xde, 0x67, 0xf2, 0xae, 0x9f, 0x05, 0xff,
+    0xa6, 0x8f, 0x33, 0x99, 0xfa, 0x20, 0x2c, 0x0c, 0xe1, 0xa6, 0x99, 0xf4, 0xef, 0x61, 0xdf, 0x02,
+    0x0c, 0xd7, 0x5f, 0xf0, 0x28, 0x08, 0x81, 0xa6, 0xf3, 0x4d, 0x0a, 0x76, 0x72, 0x7a, 0x2c, 0xe3,
+    0x71, 0x06, 0xcc, 0xd2, 0x00, 0x58, 0x13, 0x63, 0x1e, 0x06, 0x4b, 0xa0, 0x3e, 0x07, 0x1b, 0x8b,
+    0x74, 0xba, 0x93, 0x9b, 0xa5, 0xd3, 0x2d, 0x4f, 0xdd, 0xa6, 0x1d, 0xba, 0xd3, 0x8e, 0xb1, 0x87,
+    0x9e, 0xb7, 0xd5, 0x85, 0xb9, 0x28, 0x88, 0xfb, 0x2b, 0x11, 0x2c, 0x57, 0x6a, 0xc2, 0x46, 0xc3,
+    0xe1, 0xed, 0x6a, 0xda, 0xf1, 0x83, 0x2c, 0x01, 0x3f, 0x98, 0xb0, 0x45, 0x28, 0x40, 0x70, 0xfc,
+    0xdd, 0xf7, 0x83, 0x54, 0xcc, 0x55, 0x20, 0x51, 0x22, 0x19, 0xae, 0xa3, 0x78, 0xda, 0xf9, 0x65,
+    0x9d, 0xa9, 0x60, 0x81, 0xa7, 0x47, 0x8e, 0x30, 0x61, 0x59, 0xc2, 0xc1, 0x03, 0x66, 0x42, 0x6d,
+    0x84, 0x88, 0x51, 0xe1, 0xd5, 0x28, 0x57, 0x17, 0x0c, 0x22, 0x60, 0x67, 0xc8, 0xa3, 0xc4, 0x1d,
+    0x79, 0x47, 0xa9, 0x88, 0x7a, 0xec, 0xe8, 0x76, 0xd3, 0x63, 0x63, 0x78, 0xad, 0x4b, 0x58, 0x71,
+    0x8b, 0xae, 0x31, 0x47, 0xb6, 0xe2, 0xbe, 0xdc, 0x4c, 0xd8, 0x38, 0xb9, 0xa3, 0x9f, 0x23, 0xf8,
+    0x49, 0x97, 0x33, 0xee, 0x0e, 0x7b, 0xcc, 0xfc, 0xf3, 0x0e, 0xba, 0x96, 0x71, 0x46, 0x40, 0xb9,
+    0x62, 0xb6, 0x6d, 0xc7, 0x43, 0x51, 0x79, 0x10, 0x8b, 0xd4, 0x3a, 0x3e, 0x2d, 0x4e, 0x63, 0x23,
+    0x69, 0x0d, 0x76, 0x04, 0x96, 0xa3, 0x97, 0x9b, 0x24, 0x3f, 0x3d, 0xe0, 0x9d, 0x62, 0x6c, 0xf5,
+    0x6d, 0x09, 0x12, 0x99, 0x05, 0x7a, 0x3f, 0xce, 0xa9, 0xe0, 0x16, 0xdc, 0x91, 0xe2, 0x87, 0x4e,
+    0xe2, 0x0b, 0x14, 0xfe, 0xae, 0x6f, 0x06, 0x8e, 0x87, 0xc3, 0xe4, 0xce, 0x52, 0x87, 0xf1, 0xb5,
+    0x92, 0x96, 0xd0, 0xc6, 0xb4, 0x64, 0xd8, 0x03, 0xcb, 0xb0, 0x4d, 0xff, 0xa8, 0x85, 0x02, 0xae,
+    0xd1, 0x5e, 0x9a, 0x72, 0x3f, 0x58, 0x67, 0xc0, 0xfb, 0x08, 0x39, 0x91, 0x1b, 0x1b, 0x9b, 0x0f,
+    0xd9, 0x21, 0x58, 0x7b, 0xb4, 0xcb, 0xe4, 0x85, 0x72, 0x99, 0xb6, 0x47, 0x61, 0x5c, 0x70, 0x7c,
+    0xa5, 0x64, 0xb4, 0xd3, 0xc6, 0x95, 0x80, 0x1c, 0x73, 0xfc, 0x6e, 0x4a, 0x33, 0x6c, 0x4a, 0x83,
+    0xe7, 0x8f, 0xe3, 0x0d, 0x69, 0xc6, 0x2d, 0xd2, 0x4c, 0x42, 0x9e, 0xa9, 0xfe, 0x7c, 0x15, 0x84,
+    0x7e, 0x53, 0xb0, 0xa1, 0xb5, 0x7e, 0xa6, 0x50, 0xf2, 0xca, 0x01, 0x94, 0xf2, 0x8e, 0xb5, 0x14,
+    0x15, 0xd1, 0x4e, 0xca, 0xb1, 0x09, 0x8b, 0x65, 0x2c, 0xda, 0xcc, 0x6d, 0xe3, 0xd5, 0x13, 0xa1,
+    0xd8, 0x8c, 0x14, 0x30, 0xbb, 0x39, 0xce, 0xd1, 0x71, 0x72, 0x87, 0xdb, 0xd7, 0x69, 0x86, 0xfb,
+    0x13, 0x19, 0x68, 0xc7, 0x52, 0x29, 0xe0, 0x86, 0xf1, 0x22, 0x1e, 0x86, 0x78, 0x22, 0x19, 0x13,
+    0x3c, 0x13, 0xad, 0x27, 0x38, 0xdc, 0x71, 0x82, 0x35, 0xf7, 0x26, 0xe8, 0xe9, 0x07, 0x4a, 0x44,
+    0x59, 0xe9, 0xc2, 0x3b, 0x7d, 0xbb, 0xf0, 0x49, 0x3a, 0xe4, 0xba, 0x49, 0x3d, 0xf2, 0x87, 0xa6,
+    0x5d, 0x2a, 0x08, 0xdf, 0xad, 0xee, 0x99, 0xac, 0xe4, 0x2d, 0x45, 0x08, 0x69, 0xb7, 0x90, 0x29,
+    0x9c, 0x14, 0x65, 0x12, 0xc0, 0x8e, 0xe1, 0xb8, 0xbe, 0x98, 0xcf, 0x31, 0x74, 0xda, 0x56, 0x0f,
+    0xbd, 0xaf, 0x4e, 0xf4, 0xea, 0x4c, 0x71, 0xb5, 0xce, 0x9a, 0x0e, 0xaa, 0x64, 0x92, 0x0b, 0x6e,
+    0xe3, 0xaa, 0x19, 0x68, 0xc3, 0xe1, 0x92, 0x58, 0xc8, 0x67, 0x22, 0x6c, 0x03, 0xb8, 0xa1, 0x77,
+    0x42, 0x71, 0x38, 0xc6, 0x83, 0x03, 0x19, 0x5a, 0x20, 0xae, 0x9a, 0x5a, 0xba, 0xd3, 0x86, 0x5f,
+    0x7a, 0x63, 0x2d, 0x42, 0xc9, 0xee, 0x96, 0x87, 0x6b, 0xd1, 0x8a, 0xa7, 0x9a, 0x99, 0x47, 0x78,
+    0x3a, 0xf2, 0x4c, 0xe0, 0xd3, 0xb2, 0x8d, 0x01, 0xf6, 0x99, 0x0c, 0x7d, 0x9b, 0x16, 0x99, 0xa0,
+    0x22, 0x50, 0xcb, 0x71, 0xe4, 0x6b, 0x17, 0x8b, 0xfa, 0xe2, 0x9a, 0x4f, 0x6b, 0x60, 0x8d, 0xb5,
+    0x6d, 0xfb, 0x7a, 0x5b, 0x05, 0xde, 0x16, 0xc1, 0x9d, 0x00, 0xfe, 0x64, 0x6c, 0x1d, 0xcf, 0x69,
+    0x9e, 0x70, 0xf0, 0x43, 0x61, 0xf7, 0x23, 0xe3, 0xa3, 0x8d, 0x48, 0x23, 0x44, 0xb2, 0x14, 0xd7,
+    0x16, 0xae, 0x73, 0x96, 0x71, 0x08, 0xc8, 0x5a, 0xf1, 0xb6, 0xfe, 0xa3, 0x4a, 0x9a, 0xc9, 0xcd,
+    0x0a, 0x5c, 0xbd, 0x41, 0x6c, 0xb1, 0x78, 0x82, 0x5a, 0x7b, 0x64, 0x17, 0xc4, 0x16, 0x50, 0xe5,
+    0x68, 0x98, 0xaf, 0x25, 0x96, 0x3f, 0xc2, 0x5d, 0x9e, 0x03, 0xeb, 0xb6, 0x8b, 0x8f, 0x0b, 0x67,
+    0x12, 0x6a, 0x9d, 0xec, 0x88, 0x83, 0x51, 0x1b, 0x46, 0x17, 0x7b, 0x34, 0x3c, 0xb6, 0x54, 0x59,
+    0x8b, 0xc5, 0xd1, 0x97, 0xe3, 0x71, 0xdd, 0x00, 0x55, 0x5c, 0x6c, 0xe0, 0x56, 0x0d, 0x59, 0x2d,
+    0xa3, 0x8c, 0xbc, 0x11, 0xe5, 0x86, 0x16, 0x0f, 0xb0, 0xc1, 0xae, 0x08, 0x76, 0x30, 0xd9, 0x48,
+    0x43, 0x5e, 0x8f, 0xd5, 0xa5, 0xb3, 0xe1, 0xd0, 0x56, 0xa4, 0x00, 0x98, 0x16, 0x75, 0xc4, 0xf1,
+    0x21, 0x1f, 0x7d, 0x35, 0x6d, 0xc5, 0x9e, 0xa3, 0x6e, 0x8d, 0xce, 0xa3, 0xd8, 0xa3, 0x57, 0x0f,
+    0xde, 0xb0, 0x6b, 0x11, 0x83, 0xf6, 0x58, 0x57, 0x2f, 0x82, 0xe5, 0x3a, 0xe5, 0x64, 0xfb, 0x6b,
+    0xac, 0x86, 0x33, 0xf6, 0x66, 0x80, 0xf4, 0x70, 0x7e, 0xd7, 0xa9, 0xfc, 0x7f, 0x73, 0xa7, 0x91,
+    0xa5, 0x59, 0x29, 0x3d, 0x5b, 0x9a, 0x3f, 0xb1, 0xcc, 0xc8, 0x85, 0x03, 0xda, 0xb5, 0xa4, 0xf2,
+    0xb8, 0x09, 0x5a, 0x8b, 0xc2, 0xb2, 0x3a, 0xd1, 0x2a, 0xbc, 0xc4, 0x4c, 0x2d, 0xa0, 0xac, 0x11,
+    0xf8, 0x89, 0x92, 0xb6, 0x35, 0x67, 0x1a, 0x9a, 0x8b, 0x40, 0x50, 0xa9, 0x52, 0x4b, 0xca, 0x4b,
+    0x5e, 0xa0, 0x67, 0xab, 0xfc, 0xad, 0x49, 0xbb, 0x4e, 0x35, 0x13, 0x21, 0x38, 0x59, 0xaf, 0x36,
+    0x1a, 0xc4, 0xc9, 0x5a, 0xd9, 0x48, 0x75, 0xd2, 0x82, 0xc1, 0x87, 0x76, 0xb5, 0x33, 0x02, 0xcb,
+    0x64, 0x32, 0x0c, 0x7c, 0x68, 0xcd, 0x0e, 0x0f, 0x6b, 0xde, 0x78, 0x70, 0x70, 0xf0, 0x78, 0xa1,
+    0xd3, 0x2e, 0x15, 0x9a, 0x11, 0x34, 0x05, 0xb0, 0x6a, 0xae, 0xc8, 0x25, 0xd4, 0x0b, 0x46, 0x45,
+    0x9d, 0x7c, 0x42, 0xf6, 0x80, 0xd5, 0x20, 0x79, 0xdf, 0xec, 0x80, 0xb8, 0xec, 0x61, 0x7d, 0x10,
+    0x41, 0x8c, 0x5b, 0x63, 0xb6, 0x7e, 0x3b, 0x13, 0xcd, 0x61, 0xb3, 0xa4, 0x7b, 0x46, 0xc9, 0x35,
+    0xb6, 0x30, 0xa6, 0x2a, 0x48, 0x6b, 0xe9, 0x53, 0x77, 0x86, 0x46, 0x1a, 0x6a, 0x93, 0xfd, 0xb9,
+    0x95, 0x65, 0x49, 0xc5, 0x6c, 0x4f, 0xa1, 0xc1, 0x07, 0xa5, 0xb3, 0xe7, 0x80, 0xfd, 0xf3, 0x23,
+    0xaa, 0x41, 0xbf, 0xe9, 0xb0, 0x4f, 0xf5, 0x87, 0x8d, 0x92, 0x67, 0x47, 0x15, 0xd6, 0xf4, 0xad,
+    0xb6, 0x43, 0xdb, 0x11, 0x93, 0xd5, 0x0a, 0xe8, 0xd1, 0x98, 0x24, 0xa8, 0xfe, 0x28, 0xb2, 0x44,
+    0xc2, 0xf1, 0x02, 0xa8, 0xf3, 0xd8, 0x67, 0x4a, 0xae, 0xe7, 0x2b, 0xa6, 0xef, 0x36, 0x18, 0xf7,
+    0x51, 0xa5, 0x08, 0x74, 0x21, 0xd8, 0xfe, 0x3a, 0x12, 0x7e, 0xc0, 0x01, 0xee, 0x53, 0x50, 0x87,
+    0x56, 0xbb, 0xd8, 0xb0, 0xe5, 0xcd, 0xf4, 0x11, 0x76, 0x6c, 0x5d, 0x3d, 0x2e, 0xd3, 0x00, 0x76,
+    0x71, 0xed, 0x33, 0x21, 0x0c, 0x41, 0x8e, 0x48, 0x44, 0x17, 0x84, 0xb4, 0x5b, 0x52, 0x56, 0x57,
+    0x9d, 0xe9, 0x16, 0x9a, 0xb5, 0xb4, 0xd0, 0x63, 0x2a, 0x19, 0x0e, 0x75, 0xc9, 0x77, 0x44, 0x25,
+    0x43, 0xdb, 0xf6, 0x66, 0xd7, 0xc9, 0xaa, 0x47, 0xce, 0xca, 0x42, 0xa5, 0xb9, 0xbf, 0xe1, 0x2f,
+    0xb0, 0x7a, 0x9b, 0xeb, 0xed, 0x52, 0x0e, 0xd5, 0x51, 0x42, 0x9a, 0x34, 0xca, 0x77, 0x66, 0x25,
+    0x45, 0x8a, 0x25, 0x7b, 0x7b, 0xc5, 0x6c, 0xc0, 0x24, 0xef, 0xbb, 0xc6, 0xda, 0x6c, 0x0f, 0x6d,
+    0xa2, 0x5b, 0xfd, 0xf0, 0x97, 0xd4, 0x0f, 0x97, 0x22, 0x8f, 0x0b, 0x95, 0xb7, 0x9d, 0xd3, 0x81,
+    0xb9, 0x69, 0x3a, 0x1d, 0x98, 0xdb, 0x2d, 0xbc, 0x79, 0x81, 0x87, 0x1f, 0xdc, 0xb2, 0xc0, 0x3f,
+    0xdb, 0x2b, 0xcb, 0xbc, 0x6b, 0x2a, 0x56, 0xf7, 0xd0, 0xac, 0x59, 0x66, 0x4f, 0xe4, 0x65, 0x6c,
+    0xb3, 0x22, 0xdc, 0x3b, 0xbf, 0xd2, 0x2f, 0xa7, 0x03, 0xa0, 0x87, 0x37, 0x68, 0xa3, 0xfa, 0xbd,
+    0x19, 0x8c, 0x68, 0x66, 0x25, 0x59, 0xad, 0xc3, 0x5e, 0x75, 0xbc, 0xa6, 0xe1, 0x1e, 0x09, 0x47,
+    0x83, 0x17, 0xf6, 0x8e, 0xd5, 0x58, 0x33, 0xc8, 0x80, 0xf2, 0xd8, 0x52, 0x83, 0x56, 0x7e, 0xbb,
+    0x86, 0xf0, 0x89, 0xb3, 0xbd, 0xf3, 0x5c, 0x1c, 0xf3, 0xb0, 0xd8, 0xd4, 0x53, 0xba, 0xe6, 0xa3,
+    0x47, 0xeb, 0x8c, 0x74, 0xa9, 0x52, 0xe7, 0xa4, 0xd7, 0x7e, 0x34, 0x48, 0xd2, 0xe0, 0x65, 0x1e,
+    0xda, 0x91, 0xe0, 0x25, 0x39, 0xbf, 0xbc, 0xfe, 0x70, 0x32, 0x3e, 0x3e, 0x66, 0x15, 0xc3, 0x84,
+    0x22, 0x3d, 0x1d, 0x24, 0xb8, 0xbe, 0x58, 0x09, 0x5e, 0x10, 0x24, 0xea, 0xbc, 0x13, 0x0a, 0x05,
+    0xf9, 0x64, 0xfe, 0x19, 0x1e, 0x67, 0x2c, 0x5e, 0x87, 0x21, 0xc6, 0x6a, 0x9c, 0x29, 0xba, 0x19,
+    0xb9, 0xc7, 0x53, 0x82, 0x52, 0xe9, 0x8c, 0xfd, 0xf4, 0xf3, 0x94, 0x96, 0xce, 0x60, 0xff, 0xf7,
+    0x7e, 0xb1, 0x14, 0x87, 0xb0, 0xcb, 0xff, 0x87, 0x48, 0x33, 0x2c, 0xa0, 0xec, 0xf1, 0x18, 0x52,
+    0xcf, 0x85, 0x8c, 0x22, 0x70, 0x34, 0xda, 0xf1, 0x23, 0x57, 0x2b, 0x6f, 0x11, 0x4a, 0x99, 0xba,
+    0xf4, 0x0a, 0x2e, 0xea, 0xcb, 0xc8, 0xed, 0xb2, 0x37, 0xd8, 0xf3, 0x9b, 0x2f, 0xec, 0x9f, 0xd6,
+    0xb1, 0xae, 0xc6, 0x8c, 0x07, 0xfc, 0x53, 0xcc, 0xae, 0x49, 0x40, 0x17, 0x9d, 0x73, 0x30, 0x40,
+    0xa5, 0x70, 0x1c, 0x20, 0x82, 0x15, 0x73, 0x0c, 0xd6, 0xe3, 0xed, 0x28, 0x3b, 0x19, 0x31, 0x37,
+    0xb7, 0x41, 0x39, 0xeb, 0x8b, 0x05, 0x5f, 0x87, 0x8a, 0x96, 0x74, 0x7b, 0x48, 0x24, 0x15, 0xd9,
+    0x3a, 0x42, 0xf4, 0x5c, 0xa4, 0x32, 0x62, 0x6a, 0x25, 0x48, 0x0f, 0x86, 0xce, 0x27, 0xd8, 0x46,
+    0xb0, 0x8c, 0x6f, 0xc0, 0x2e, 0x40, 0x36, 0xbc, 0x67, 0x51, 0x90, 0x65, 0xc2, 0x67, 0xf3, 0x15,
+    0xe2, 0x7e, 0xc6, 0x78, 0x0a, 0xd3, 0x80, 0x2a, 0x85, 0xa1, 0x80, 0x92, 0x00, 0x05, 0x8d, 0x6d,
+    0x5e, 0x9d, 0x69, 0x2b, 0xb0, 0xb7, 0xec, 0x66, 0xf0, 0x16, 0x07, 0xcf, 0x5e, 0x3f, 0xe8, 0xb9,
+    0xed, 0x5f, 0x6f, 0xb5, 0xa1, 0x60, 0xc4, 0x32, 0xdb, 0xf6, 0x86, 0x4d, 0x98, 0x33, 0x70, 0xa6,
+    0x9d, 0xf2, 0x24, 0xc4, 0xa6, 0x14, 0xdf, 0x75, 0x36, 0xd9, 0x64, 0x30, 0x70, 0xd8, 0x3e, 0xdb,
+    0x04, 0x60, 0xb4, 0x8d, 0x17, 0xca, 0x39, 0x61, 0x9a, 0xb7, 0x92, 0x99, 0xc2, 0xfb, 0x61, 0x98,
+    0x72, 0x26, 0x27, 0x23, 0x5c, 0xa2, 0xe5, 0xe9, 0xe6, 0xc4, 0x3c, 0x19, 0xcb, 0x44, 0xe0, 0xd1,
+    0x80, 0xfd, 0xce, 0xce, 0x31, 0x5b, 0xc8, 0xf9, 0x1a, 0xb1, 0xd4, 0x5b, 0x0a, 0x75, 0x19, 0x0a,
+    0x7c, 0xfd, 0xf6, 0xfe, 0x7b, 0xdf, 0x75, 0xea, 0xd1, 0xe9, 0x74, 0x3d, 0x72, 0xe4, 0xf7, 0x9c,
+    0xf4, 0x73, 0x1e, 0x0f, 0x52, 0xea, 0x01, 0x41, 0x87, 0xdf, 0x42, 0x5e, 0x91, 0x8f, 0x50, 0x96,
+    0x42, 0x06, 0x57, 0x39, 0x0d, 0xb4, 0xac, 0x0c, 0x05, 0xe8, 0xb9, 0x74, 0x9d, 0xf2, 0x18, 0x0d,
+    0x05, 0xe1, 0x3b, 0x98, 0x35, 0x2c, 0x0d, 0xe7, 0xa1, 0xcc, 0xc4, 0x9f, 0xaf, 0xa2, 0x86, 0x9f,
+    0xdf, 0xa9, 0x63, 0x41, 0x64, 0x87, 0x92, 0x90, 0xcc, 0x0b, 0x3d, 0x7b, 0x70, 0x9a, 0x2a, 0xbd,
+    0x07, 0x3f, 0xf5, 0x3c, 0x0f, 0x95, 0x86, 0x06, 0xe8, 0x53, 0x10, 0x09, 0xb9, 0x56, 0x6e, 0x3d,
+    0x3c, 0xa0, 0x8f, 0xd5, 0x01, 0x64, 0x1b, 0x46, 0xa4, 0x29, 0xf4, 0x3f, 0x60, 0x18, 0x7a, 0x31,
+    0xd6, 0xc9, 0x19, 0xd3, 0x98, 0xcd, 0x9a, 0x06, 0x26, 0x4e, 0x4f, 0xbf, 0xd4, 0x48, 0x45, 0xd0,
+    0xc0, 0xf3, 0x25, 0x59, 0x59, 0xdc, 0x82, 0x32, 0x86, 0x18, 0x88, 0x67, 0x48, 0x82, 0xe8, 0x5c,
+    0x71, 0x98, 0xff, 0xfb, 0xf5, 0xd5, 0x7b, 0x2f, 0xe1, 0x69, 0x26, 0xf4, 0x4a, 0x0f, 0xc7, 0xbb,
+    0x35, 0x85, 0x3f, 0x8a, 0xb9, 0x80, 0x64, 0xef, 0x23, 0x3b, 0x33, 0x1f, 0x2c, 0x98, 0x8b, 0xaf,
+    0x9e, 0x89, 0x12, 0x0a, 0x25, 0xa8, 0x3e, 0xc4, 0x02, 0x0c, 0xe6, 0x63, 0xf4, 0x57, 0xb1, 0xc6,
+    0x5e, 0x8b, 0x55, 0x44, 0xb1, 0x5f, 0xdd, 0x27, 0x20, 0x27, 0x6c, 0x76, 0x08, 0xc5, 0x1c, 0xdc,
+    0xba, 0x4e, 0x60, 0x4a, 0x7c, 0x2c, 0x50, 0x4d, 0xaf, 0x84, 0x70, 0x12, 0x77, 0x5a, 0x00, 0xba,
+    0x76, 0xc1, 0xb8, 0xd9, 0x32, 0x11, 0x82, 0x37, 0xed, 0xa2, 0x96, 0x11, 0xb9, 0x72, 0x47, 0xe6,
+    0x41, 0xa2, 0xbd, 0xe4, 0xf3, 0x95, 0xeb, 0xd2, 0x67, 0xfc, 0x1b, 0x0c, 0x10, 0x25, 0xf3, 0x34,
+    0x98, 0x1a, 0x7e, 0x9a, 0xd5, 0xa3, 0xbc, 0x34, 0xf2, 0x5b, 0xa2, 0x5f, 0xdb, 0xa9, 0xc0, 0x35,
+    0x26, 0x7b, 0x6a, 0xbf, 0x2d, 0xac, 0x1e, 0x28, 0xa4, 0x6d, 0xa1, 0xfa, 0x38, 0xc1, 0x98, 0x27,
+    0xd9, 0x4a, 0x2a, 0xa2, 0x58, 0xe4, 0x01, 0x5a, 0x84, 0x9f, 0xa6, 0x9a, 0x8b, 0x36, 0xd1, 0xef,
+    0x31, 0xc9, 0x1f, 0x22, 0xac, 0x2f, 0x42, 0xc5, 0x4b, 0xdd, 0xeb, 0x52, 0xd1, 0xe7, 0x76, 0x71,
+    0x68, 0x2a, 0xf7, 0x0b, 0xfd, 0xe1, 0x19, 0xa7, 0x15, 0x43, 0xa9, 0x4c, 0xec, 0x72, 0x1f, 0xdf,
+    0xf0, 0x34, 0x76, 0x1d, 0x93, 0xff, 0x80, 0xce, 0x2f, 0x14, 0xcf, 0xb9, 0xb3, 0x7b, 0x81, 0x4f,
+    0x75, 0xef, 0x96, 0x01, 0x8e, 0x43, 0x9d, 0xeb, 0x8a, 0x6e, 0x33, 0x2e, 0x2f, 0x29, 0x76, 0x93,
+    0x54, 0xe2, 0xd5, 0x19, 0xa6, 0x2a, 0x13, 0x81, 0x14, 0xa0, 0x7a, 0x3b, 0x5d, 0x77, 0xe5, 0xf9,
+    0xf2, 0x71, 0xcb, 0x02, 0x7d, 0x2b, 0xa5, 0xff, 0x44, 0x73, 0x3f, 0xc3, 0x01, 0xd2, 0x6c, 0x9e,
+    0xf4, 0x67, 0x54, 0xd3, 0xe0, 0xb1, 0xee, 0x00, 0xb8, 0x1b, 0x5d, 0x39, 0xbd, 0x7e, 0xa0, 0xfd,
+    0xdb, 0x1b, 0x13, 0xb5, 0x7a, 0x1f, 0x39, 0x06, 0xbd, 0x55, 0x40, 0xf5, 0xa6, 0xbc, 0xe5, 0x7f,
+    0xfd, 0xa0, 0x13, 0xec, 0x5b, 0xe6, 0xc8, 0xd8, 0xc1, 0xac, 0xe7, 0x6c, 0x6f, 0xa6, 0xf9, 0xa6,
+    0x2a, 0x52, 0xde, 0xe8, 0x12, 0xc6, 0xb0, 0x82, 0xc4, 0x36, 0xda, 0x4e, 0x6c, 0x02, 0x57, 0xef,
+    0x89, 0xc0, 0xd5, 0xbb, 0x77, 0x44, 0x63, 0x6b, 0x9b, 0x42, 0xc9, 0xe5, 0x32, 0xd4, 0xa6, 0x70,
+    0x8d, 0xeb, 0x3d, 0x90, 0xa0, 0xaf, 0x4c, 0x86, 0xfd, 0xf5, 0x57, 0x53, 0xf5, 0x78, 0xd8, 0x45,
+    0x69, 0xa3, 0x10, 0xdc, 0x14, 0x60, 0xe8, 0x5d, 0x7d, 0xb8, 0x7c, 0x8f, 0xdb, 0x38, 0x54, 0x4f,
+    0xca, 0x46, 0xc9, 0x58, 0x5a, 0x99, 0xc8, 0x63, 0x1f, 0x42, 0x6c, 0x41, 0xa1, 0x3a, 0x10, 0xf3,
+    0xcf, 0xec, 0x5e, 0xae, 0x53, 0x2b, 0x65, 0x10, 0x66, 0x03, 0x84, 0xaf, 0x53, 0x02, 0x28, 0x6d,
+    0xe4, 0x12, 0x48, 0x01, 0x3d, 0xc1, 0x83, 0x26, 0x39, 0x4c, 0xf5, 0x3a, 0x01, 0x74, 0x5a, 0x95,
+    0xba, 0x69, 0x7f, 0x1f, 0x06, 0x51, 0x81, 0x89, 0x0e, 0xa1, 0x5e, 0x87, 0xf4, 0x9f, 0xb0, 0x57,
+    0xcd, 0xc3, 0xb4, 0xd0, 0x1a, 0xc2, 0xc7, 0x77, 0x09, 0x86, 0x33, 0x95, 0x82, 0xeb, 0x40, 0x37,
+    0xe8, 0x1a, 0xb6, 0xe4, 0xc7, 0x56, 0x91, 0x05, 0xfa, 0x1b, 0xa7, 0x31, 0x05, 0xad, 0xdb, 0x2d,
+    0xf0, 0xbc, 0x6c, 0x01, 0x76, 0x7b, 0x84, 0x63, 0x17, 0xc3, 0x8e, 0x46, 0x79, 0xbd, 0x09, 0x82,
+    0x08, 0x7e, 0x7f, 0xf7, 0xe9, 0xc7, 0x1f, 0x30, 0xef, 0x39, 0x78, 0xd7, 0x98, 0x32, 0x17, 0x4b,
+    0xc3, 0x00, 0x06, 0x86, 0x53, 0x78, 0x9c, 0xb2, 0x43, 0x78, 0xec, 0xef, 0x97, 0x2c, 0x9b, 0x1e,
+    0xa8, 0x25, 0x34, 0x2c, 0x5d, 0x47, 0x2f, 0x40, 0x46, 0xc6, 0x6b, 0x02, 0xbf, 0xf4, 0x31, 0x70,
+    0x16, 0xcb, 0x9f, 0x2a, 0x99, 0xbd, 0x70, 0x42, 0xe7, 0x49, 0x7f, 0x33, 0xbe, 0x06, 0x9e, 0x55,
+    0xd2, 0xc2, 0x1a, 0x23, 0x80, 0x03, 0xce, 0x6b, 0x8c, 0x8a, 0x87, 0x55, 0xb4, 0xe6, 0x09, 0x94,
+    0x5b, 0xfe, 0x05, 0xfe, 0xd9, 0x2b, 0x8f, 0x8b, 0x69, 0x35, 0xf4, 0x30, 0xec, 0x16, 0x3c, 0xd4,
+    0xf7, 0x16, 0x8d, 0x00, 0x6e, 0xc1, 0xf9, 0xdf, 0x76, 0x20, 0xd5, 0x9e, 0x01, 0x2d, 0x45, 0x45,
+    0xbe, 0xee, 0x3a, 0xf0, 0x02, 0xef, 0x91, 0xf0, 0x36, 0x1d, 0xcb, 0xeb, 0x87, 0x32, 0x3b, 0x16,
+    0x41, 0xfe, 0xaa, 0x24, 0x81, 0x12, 0xb5, 0x13, 0xac, 0x9d, 0x16, 0xf4, 0x27, 0xba, 0x6c, 0xc9,
+    0xd7, 0x9a, 0xe3, 0x6a, 0xe5, 0x53, 0x59, 0x57, 0x39, 0x3c, 0xeb, 0xfa, 0xd1, 0xd9, 0x65, 0x6b,
+    0x4b, 0x3a, 0xb4, 0x2b, 0xea, 0x8c, 0xff, 0xd3, 0x02, 0xb9, 0x9d, 0xae, 0x0e, 0x4c, 0x7f, 0xc5,
+    0x6c, 0x8e, 0x74, 0xce, 0xd0, 0x70, 0x1d, 0x9c, 0xdf, 0x58, 0xc5, 0x87, 0x12, 0x51, 0x22, 0x52,
+    0x28, 0xde, 0x52, 0xd1, 0x2c, 0x40, 0x88, 0xe2, 0x3e, 0x92, 0x6c, 0xb6, 0x79, 0x74, 0xfd, 0xb1,
+    0x77, 0xfe, 0xa9, 0xdc, 0x3f, 0xc9, 0xd9, 0x59, 0x34, 0x3d, 0x25, 0xdf, 0xe1, 0x5f, 0x65, 0xdc,
+    0x51, 0x77, 0xfb, 0xdf, 0xff, 0x5c, 0xe8, 0x16, 0xee, 0xa6, 0x52, 0xbe, 0xac, 0xa0, 0x33, 0xf1,
+    0x03, 0x75, 0xff, 0x22, 0xf6, 0xdf, 0x99, 0xcd, 0x05, 0xef, 0x9c, 0x9a, 0xcd, 0xf8, 0x8b, 0x36,
+    0xb6, 0x91, 0x0c, 0xb2, 0x17, 0x6b, 0xfd, 0xa3, 0xd9, 0x5c, 0xb0, 0xcd, 0xa9, 0x3d, 0xc9, 0x36,
+    0xc4, 0x5b, 0x9b, 0x17, 0xf1, 0xfc, 0x41, 0xdf, 0xf7, 0x18, 0x86, 0x44, 0xc7, 0xe6, 0xd6, 0xc6,
+    0x8c, 0xc7, 0x1c, 0xaa, 0xcf, 0x17, 0x71, 0xfb, 0x86, 0xb6, 0x16, 0xec, 0x34, 0xa5, 0x1d, 0xfc,
+    0x6c, 0x7f, 0xb7, 0x40, 0x10, 0xb9, 0xe0, 0xb4, 0xe9, 0xe2, 0xa0, 0x65, 0x92, 0xdc, 0xb7, 0xda,
+    0x96, 0x36, 0x30, 0x26, 0x77, 0xaf, 0xf5, 0xc1, 0x54, 0x98, 0x9f, 0x0e, 0xf2, 0x1e, 0xfe, 0x74,
+    0x60, 0xae, 0x59, 0x06, 0xf4, 0x5f, 0x8b, 0xfe, 0x07, 0xae, 0xf4, 0x14, 0x3d, 0x71, 0x24, 0x00,
+    0x00,
+};
+
+#define SETUP_UI_GZ_ETAG "\"aa344009d73c9837\""
+const uint8_t SETUP_UI_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x58, 0x6d, 0x73, 0xda, 0x38,
+    0x10, 0xfe, 0xce, 0xaf, 0x50, 0xdd, 0xde, 0x00, 0x93, 0xf0, 0x62, 0x08, 0xbd, 0x2b, 0x01, 0x66,
+    0x7a, 0xa1, 0xbd, 0x64, 0xae, 0x49, 0x98, 0x92, 0x9b, 0xce, 0x7d, 0xba, 0xc8, 0x96, 0x00, 0xb5,
+    0xb6, 0xe5, 0xb3, 0x64, 0x12, 0x2e, 0x93, 0xff, 0x7e, 0xab, 0x17, 0x63, 0x63, 0xc0, 0x49, 0x27,
+    0x33, 0xb1, 0x2d, 0xed, 0xae, 0x76, 0x9f, 0x7d, 0x15, 0xa3, 0x37, 0xd3, 0xdb, 0x8b, 0xbb, 0xbf,
+    0x67, 0x9f, 0xd0, 0x4a, 0x86, 0xc1, 0xa4, 0x36, 0xca, 0x1e, 0x14, 0x13, 0x78, 0x48, 0x26, 0x03,
+    0x3a, 0x99, 0xd2, 0x35, 0xf3, 0x29, 0xba, 0xe0, 0xd1, 0x82, 0x2d, 0xd3, 0x04, 0x4b, 0xc6, 0xa3,
+    0x51, 0xc7, 0xec, 0xd5, 0x46, 0x21, 0x95, 0x18, 0x45, 0x38, 0xa4, 0x63, 0x67, 0xcd, 0xe8, 0x43,
+    0xcc, 0x13, 0xe9, 0x20, 0x9f, 0x47, 0x92, 0x46, 0x72, 0xec, 0x3c, 0x30, 0x22, 0x57, 0x63, 0xa2,
+    0x25, 0xb4, 0xf4, 0xc7, 0x29, 0x62, 0x11, 0x93, 0x0c, 0x07, 0x2d, 0xe1, 0xe3, 0x80, 0x8e, 0x5d,
+    0x07, 0x84, 0x08, 0xb9, 0x51, 0xc2, 0x3c, 0x4e, 0x36, 0xe8, 0xa9, 0xb6, 0x00, 0xee, 0xd6, 0x02,
+    0x87, 0x2c, 0xd8, 0x0c, 0x51, 0xfd, 0x63, 0x02, 0xc4, 0xf5, 0x53, 0x24, 0x70, 0x24, 0x5a, 0x82,
+    0x26, 0x6c, 0x71, 0x5e, 0x0b, 0xf1, 0xa3, 0x91, 0x36, 0x44, 0x83, 0x6e, 0x37, 0x7e, 0x54, 0x2b,
+    0xc9, 0x92, 0x45, 0x43, 0xd4, 0x45, 0x38, 0x95, 0xfc, 0xbc, 0x16, 0x63, 0x42, 0x58, 0xb4, 0x1c,
+    0xa2, 0x9e, 0xde, 0xf6, 0xb0, 0xff, 0x63, 0x99, 0xf0, 0x34, 0x22, 0x2d, 0x9f, 0x07, 0x3c, 0x19,
+    0xa2, 0xb7, 0x6e, 0x4f, 0xfd, 0x9d, 0xd7, 0xb2, 0x6f, 0xda, 0x55, 0x7f, 0xe7, 0xb5, 0xe7, 0xda,
+    0xca, 0x3d, 0x45, 0xab, 0x1e, 0x28, 0x22, 0xe9, 0xa3, 0x6c, 0xe1, 0x80, 0x2d, 0x41, 0xb0, 0x0f,
+    0xf6, 0xd0, 0xc4, 0x6c, 0xc3, 0x56, 0xc6, 0xb5, 0x58, 0x78, 0x67, 0x5d, 0xcd, 0xc5, 0xa2, 0x38,
+    0x95, 0xa0, 0x26, 0x0d, 0xa8, 0x2f, 0x81, 0xc2, 0xea, 0xe7, 0x76, 0xbb, 0xbf, 0x14, 0xd4, 0x71,
+    0x77, 0xb4, 0x55, 0x5f, 0x08, 0xb8, 0x3d, 0xfe, 0xd8, 0x12, 0xec, 0x3f, 0x4d, 0xe1, 0xf1, 0x84,
+    0xd0, 0xa4, 0x05, 0x4b, 0x6a, 0x5d, 0xbd, 0x03, 0x1d, 0x90, 0x09, 0x1e, 0x30, 0x82, 0xde, 0xf6,
+    0xfb, 0xfd, 0xc3, 0xe6, 0x50, 0xf5, 0xb7, 0x6f, 0x8e, 0x15, 0x97, 0x60, 0xc2, 0x52, 0x01, 0x70,
+    0xa9, 0xe3, 0xad, 0xb2, 0xc3, 0x05, 0xf7, 0x53, 0x91, 0xa9, 0x6c, 0xbe, 0x40, 0x71, 0x9e, 0xca,
+    0x80, 0x45, 0x74, 0x88, 0x22, 0x1e, 0xd1, 0xad, 0x80, 0xb2, 0xc1, 0x5a, 0xe5, 0x15, 0x26, 0xfc,
+    0x41, 0x81, 0xde, 0x55, 0x82, 0x8b, 0x68, 0xb4, 0x05, 0x88, 0x84, 0x40, 0x01, 0x79, 0x47, 0x8d,
+    0xd8, 0xd5, 0xcc, 0x20, 0x93, 0x03, 0x35, 0xc8, 0x81, 0x02, 0x30, 0xa4, 0xe4, 0x61, 0xb6, 0x58,
+    0x61, 0xbd, 0x3a, 0x38, 0xf5, 0x42, 0x26, 0x5b, 0x9e, 0xd4, 0x67, 0xef, 0x93, 0x2e, 0x16, 0x83,
+    0x5f, 0x7b, 0xb9, 0xdf, 0x1f, 0x56, 0x4c, 0xd2, 0x1c, 0x69, 0x63, 0xb3, 0x9f, 0x26, 0x42, 0x6d,
+    0xc6, 0x9c, 0x19, 0xaf, 0xe7, 0x6a, 0xf5, 0x94, 0x06, 0x3a, 0x42, 0xc1, 0x61, 0x00, 0x92, 0xdb,
+    0x76, 0x69, 0x78, 0x18, 0x66, 0x99, 0x40, 0xc8, 0x32, 0x85, 0xc2, 0x10, 0xe9, 0xf7, 0x05, 0x4f,
+    0x42, 0xd4, 0x6d, 0xbb, 0x02, 0x51, 0x2c, 0xe8, 0x29, 0x2a, 0x6b, 0x07, 0x7b, 0x7d, 0xb3, 0x57,
+    0xb2, 0x64, 0xb8, 0xe2, 0x6b, 0x9a, 0x1c, 0xb6, 0x87, 0xbe, 0x3f, 0xc3, 0xee, 0x07, 0x7b, 0x9a,
+    0x3a, 0x61, 0x88, 0x74, 0x66, 0x35, 0xdc, 0x76, 0x77, 0xd0, 0x2c, 0x0b, 0xc2, 0xe0, 0x95, 0x35,
+    0x55, 0xb1, 0x5d, 0x26, 0xef, 0xb6, 0x3f, 0x18, 0xf2, 0xb7, 0x98, 0xe0, 0x45, 0x92, 0x32, 0xf9,
+    0x99, 0xd1, 0x80, 0xa8, 0x88, 0xb0, 0x5e, 0x90, 0x3c, 0xce, 0x5c, 0x00, 0x42, 0x13, 0x1a, 0xe0,
+    0x0d, 0x24, 0x64, 0x04, 0x48, 0xb5, 0x16, 0xaf, 0x20, 0x8d, 0x61, 0x5d, 0xd3, 0xe5, 0x64, 0x5b,
+    0xbf, 0x76, 0x0d, 0xe5, 0xa8, 0x63, 0x2b, 0xc1, 0xa8, 0x63, 0x4b, 0x90, 0x2a, 0x09, 0xaa, 0x20,
+    0xb9, 0x47, 0xca, 0x10, 0x6c, 0xd4, 0x46, 0x1a, 0x57, 0xac, 0xe3, 0x6d, 0xec, 0x74, 0x04, 0x5e,
+    0x53, 0x40, 0x47, 0x91, 0x39, 0x08, 0xca, 0xd3, 0x8a, 0x93, 0xb1, 0x33, 0xbb, 0x9d, 0xdf, 0xa9,
+    0x4a, 0x43, 0xd8, 0x1a, 0xf9, 0x01, 0x16, 0x62, 0xec, 0xd8, 0x08, 0x55, 0xab, 0xab, 0xde, 0xe4,
+    0x1b, 0xfb, 0xcc, 0xf6, 0x84, 0xf7, 0x60, 0x4f, 0xa7, 0x0a, 0x92, 0x9b, 0x18, 0x2a, 0x9c, 0x2a,
+    0x08, 0x8e, 0xad, 0x76, 0x0f, 0x6c, 0xc1, 0xe6, 0xf3, 0xab, 0xa9, 0x83, 0xe2, 0x00, 0xfb, 0x74,
+    0xc5, 0x03, 0x08, 0x80, 0xb1, 0xa3, 0xe5, 0x98, 0xf5, 0x84, 0xfe, 0x9b, 0xb2, 0x84, 0x92, 0x92,
+    0x90, 0x18, 0x4e, 0x7f, 0x80, 0x70, 0x29, 0x0a, 0x9a, 0x6d, 0xd7, 0xf6, 0x85, 0xe5, 0x7b, 0x05,
+    0x81, 0x1d, 0x30, 0xa4, 0xca, 0x1c, 0x8b, 0xd6, 0x0d, 0x9c, 0xf0, 0x82, 0x1d, 0x21, 0x89, 0x84,
+    0x22, 0x2b, 0x1d, 0x1d, 0x4e, 0x6f, 0xe6, 0x9a, 0x1d, 0x35, 0x68, 0x7b, 0xd9, 0x3e, 0x45, 0x54,
+    0xc4, 0x2d, 0x53, 0xc8, 0x9b, 0x0e, 0x5a, 0xe3, 0x20, 0x05, 0xde, 0x7c, 0xcd, 0x79, 0x85, 0x4e,
+    0x1f, 0x6d, 0x5c, 0xa1, 0xab, 0x5b, 0xab, 0x93, 0x2d, 0x96, 0x46, 0x91, 0x54, 0xd0, 0x8c, 0xe2,
+    0xea, 0x56, 0xb1, 0xf0, 0x58, 0x57, 0x10, 0x7b, 0xd6, 0x02, 0x07, 0x02, 0x8e, 0x99, 0x32, 0x81,
+    0xbd, 0x80, 0xa2, 0x1d, 0x61, 0x86, 0x72, 0x8f, 0x45, 0x26, 0x29, 0x70, 0x7c, 0x8a, 0x2a, 0x18,
+    0x3a, 0x46, 0x05, 0xab, 0x36, 0x83, 0x48, 0xd9, 0x8d, 0x7e, 0x07, 0xe9, 0x88, 0x1c, 0x3b, 0x84,
+    0x09, 0xc0, 0x67, 0x33, 0xd4, 0x05, 0xc2, 0xa9, 0xc0, 0x93, 0xf1, 0xbf, 0xa0, 0x4b, 0x45, 0xfb,
+    0x88, 0x16, 0x14, 0x40, 0x5b, 0x92, 0x4a, 0x41, 0x7f, 0xd2, 0x4d, 0x85, 0x0c, 0xb5, 0x5b, 0xc1,
+    0xae, 0x93, 0xee, 0x33, 0xa5, 0xe4, 0x80, 0x73, 0xbf, 0xaa, 0x3d, 0xa4, 0x36, 0x91, 0xd9, 0xb5,
+    0x80, 0x69, 0x9e, 0x4a, 0x9d, 0xe2, 0x23, 0x12, 0xaf, 0x66, 0x07, 0xc4, 0xb1, 0xb8, 0x10, 0x16,
+    0x2f, 0x45, 0x87, 0xd6, 0x49, 0xd8, 0xc0, 0xc8, 0x9c, 0x61, 0x8c, 0xb0, 0x9e, 0xb0, 0x6c, 0x07,
+    0x0a, 0x4f, 0x59, 0xe5, 0x28, 0x0d, 0x3d, 0x9a, 0xec, 0x20, 0x71, 0x01, 0x45, 0x13, 0xcc, 0xd8,
+    0x0a, 0xb5, 0xdf, 0x3b, 0x46, 0xdc, 0x68, 0x36, 0xc4, 0x17, 0xc8, 0x28, 0x83, 0x1a, 0xdd, 0xd6,
+    0x19, 0x44, 0x7b, 0xc8, 0xa0, 0xae, 0x74, 0xe1, 0x89, 0x1f, 0xc7, 0xce, 0xd9, 0xd6, 0x3c, 0x58,
+    0xe1, 0x91, 0xbf, 0xc2, 0xd1, 0x52, 0x45, 0x6f, 0x4c, 0xb0, 0xa4, 0x9a, 0x6f, 0xc6, 0x22, 0xd1,
+    0x68, 0x3a, 0x65, 0x33, 0xd4, 0xb2, 0x33, 0x29, 0xc1, 0xf1, 0x12, 0x2a, 0x73, 0x6d, 0x66, 0x19,
+    0x16, 0x63, 0xfc, 0xeb, 0x70, 0xb1, 0x39, 0x96, 0xb3, 0xdd, 0x01, 0x44, 0x45, 0xcd, 0xa1, 0xb5,
+    0xcd, 0x73, 0x79, 0x46, 0xf1, 0xdd, 0x3c, 0x72, 0x20, 0x75, 0x09, 0x32, 0x44, 0x47, 0x93, 0x0d,
+    0x06, 0xb9, 0xe9, 0xe5, 0x9d, 0xeb, 0x76, 0x7a, 0x3d, 0xd4, 0xb8, 0xa3, 0x61, 0xdc, 0xb9, 0x4c,
+    0x43, 0x46, 0x9a, 0x47, 0x19, 0x7a, 0xce, 0x64, 0xce, 0x59, 0x80, 0xae, 0x39, 0x13, 0x32, 0x4d,
+    0xe8, 0x51, 0xc2, 0xbe, 0x33, 0xf9, 0x06, 0xd8, 0x26, 0xe8, 0x0b, 0x5d, 0xd3, 0xe0, 0x28, 0xd9,
+    0x99, 0x33, 0xf9, 0x32, 0xfd, 0x7a, 0x74, 0x7b, 0x00, 0xdb, 0xd7, 0xfd, 0x41, 0x65, 0xee, 0x1b,
+    0x80, 0x4c, 0x17, 0x38, 0xea, 0xab, 0x62, 0xa0, 0x99, 0xce, 0xba, 0x8d, 0x88, 0x39, 0xb4, 0x9e,
+    0xdd, 0x26, 0xb2, 0xf5, 0x4e, 0xde, 0x83, 0x75, 0x4e, 0xa8, 0x96, 0xa5, 0x9c, 0xe3, 0x27, 0x2c,
+    0x06, 0x0d, 0x02, 0x2a, 0x51, 0x76, 0x38, 0xc4, 0xa5, 0x40, 0x63, 0xf4, 0x84, 0xc8, 0x4a, 0xc2,
+    0x6c, 0x05, 0xf3, 0x19, 0xa0, 0xa4, 0x5f, 0x1e, 0x14, 0x0a, 0xfa, 0x2d, 0x20, 0xf6, 0x19, 0xf6,
+    0x07, 0x6a, 0xfe, 0x7a, 0x86, 0x99, 0x24, 0x8d, 0xcc, 0xc4, 0x55, 0xf6, 0xa7, 0x9e, 0x56, 0x23,
+    0x61, 0x54, 0x06, 0xc1, 0x04, 0xe6, 0xbc, 0x10, 0xa6, 0xd9, 0xf6, 0x92, 0xca, 0x4f, 0x01, 0x55,
+    0xaf, 0xbf, 0x6f, 0xae, 0x48, 0xa3, 0x9e, 0x87, 0x47, 0xbd, 0xd9, 0xd6, 0x16, 0x9d, 0xd7, 0xd8,
+    0x02, 0x35, 0xde, 0x28, 0xc6, 0x26, 0x74, 0x1f, 0xf0, 0x52, 0x74, 0x6e, 0x85, 0xa9, 0x11, 0x1f,
+    0xc3, 0x98, 0x98, 0xbc, 0x2c, 0xd1, 0xe2, 0x59, 0x6f, 0x66, 0xbc, 0x2c, 0x22, 0xf4, 0x11, 0xf8,
+    0x6e, 0xbd, 0xef, 0x80, 0xbf, 0x39, 0x4a, 0x34, 0x8a, 0xf6, 0x37, 0x61, 0x66, 0x20, 0xa9, 0x4f,
+    0x1b, 0x0d, 0x7c, 0xea, 0x35, 0xd1, 0x78, 0x82, 0xf0, 0x89, 0x07, 0xfc, 0x0a, 0x27, 0x75, 0x47,
+    0x01, 0xe6, 0xfb, 0xdd, 0xa4, 0xd1, 0x51, 0x6f, 0xbb, 0x7e, 0xc9, 0x49, 0x2b, 0x46, 0x08, 0x8d,
+    0xb2, 0x6a, 0x60, 0x48, 0xdf, 0x3d, 0x69, 0x25, 0x9e, 0xff, 0x91, 0x3a, 0x1b, 0xac, 0xff, 0xde,
+    0x3d, 0xa9, 0xcf, 0x67, 0x25, 0x20, 0xc0, 0x1e, 0x0d, 0x6c, 0xfa, 0x21, 0x4b, 0x8d, 0x4e, 0x90,
+    0xfb, 0x3c, 0x1c, 0x75, 0xcc, 0xde, 0xbd, 0x41, 0xc7, 0xa0, 0x3a, 0x1e, 0x23, 0xc8, 0x00, 0x85,
+    0xb5, 0x56, 0xef, 0x44, 0xe9, 0xb7, 0xd3, 0xdd, 0x4a, 0xc7, 0x82, 0x6f, 0x75, 0x1e, 0xee, 0xa7,
+    0x51, 0x96, 0x47, 0xc7, 0xf3, 0xa6, 0xa7, 0x29, 0x7a, 0xbd, 0x03, 0xa1, 0x7c, 0xaf, 0x2f, 0x28,
+    0x5b, 0x0d, 0x8e, 0xd7, 0xc4, 0x92, 0x3a, 0x30, 0x9b, 0x95, 0x6a, 0xe1, 0x1f, 0x33, 0x68, 0x31,
+    0x33, 0xb5, 0x7c, 0x64, 0x8c, 0xa9, 0x94, 0x47, 0x60, 0x7a, 0xf3, 0x70, 0x54, 0x9e, 0x67, 0xa6,
+    0x76, 0x19, 0x0a, 0x6b, 0xdb, 0x45, 0x29, 0x5c, 0x04, 0x05, 0x02, 0x78, 0x7f, 0x29, 0xd7, 0xd8,
+    0xde, 0x60, 0xe0, 0x94, 0xc7, 0x83, 0x23, 0x27, 0x5c, 0x73, 0x72, 0x00, 0xc5, 0x2e, 0x94, 0x2c,
+    0x0f, 0x2e, 0x1b, 0xa9, 0xa4, 0x55, 0x05, 0x6b, 0x46, 0x13, 0x75, 0xaf, 0x3b, 0x58, 0x13, 0x5e,
+    0x6d, 0x2b, 0x68, 0x3c, 0x67, 0x01, 0x8d, 0xfc, 0x72, 0x4f, 0xbc, 0xa4, 0x38, 0x91, 0x1e, 0xc5,
+    0x12, 0x35, 0x44, 0x66, 0xa1, 0x5b, 0xb4, 0xb0, 0x18, 0x41, 0x6f, 0x7e, 0x36, 0x82, 0xd4, 0x8d,
+    0x40, 0xe0, 0x30, 0x0e, 0x0e, 0x9b, 0xef, 0x82, 0xdf, 0x30, 0xa9, 0x32, 0xfe, 0x4c, 0x53, 0x88,
+    0x8a, 0xfa, 0x6c, 0x6f, 0x86, 0xe0, 0x7a, 0xf7, 0xfd, 0x0b, 0xc4, 0x50, 0xa3, 0xdf, 0xef, 0x0b,
+    0xcc, 0xd1, 0xac, 0xb2, 0x24, 0xa4, 0x84, 0xe1, 0xe8, 0xa0, 0x15, 0x37, 0x1c, 0x99, 0xdd, 0x0a,
+    0x43, 0x72, 0x2d, 0xaf, 0x35, 0xa9, 0xea, 0xdf, 0xfd, 0xaa, 0xae, 0x93, 0x93, 0x0d, 0x7e, 0x5a,
+    0x57, 0x11, 0x72, 0x2e, 0x57, 0x70, 0x15, 0x3c, 0xa6, 0xee, 0x96, 0xa0, 0x0a, 0xfa, 0x79, 0x46,
+    0x84, 0xa0, 0x5d, 0xbe, 0xca, 0x01, 0x45, 0x8e, 0xb3, 0x2a, 0x2f, 0x14, 0x09, 0x7f, 0xab, 0xea,
+    0x95, 0x45, 0x42, 0xf7, 0xfd, 0x8b, 0xb5, 0x04, 0xae, 0x62, 0x29, 0x5c, 0xd6, 0x22, 0x9b, 0x11,
+    0xe6, 0x43, 0x8f, 0x11, 0x01, 0xf3, 0x7f, 0xc0, 0x94, 0xb8, 0x62, 0xa2, 0x1d, 0xe3, 0x04, 0xd2,
+    0xc9, 0xb6, 0x00, 0x28, 0xe1, 0x21, 0x04, 0xa9, 0x1a, 0x28, 0xbe, 0xea, 0xb7, 0x51, 0xc7, 0x70,
+    0x65, 0xad, 0xf4, 0x5e, 0xf7, 0x03, 0xd3, 0x45, 0xda, 0x30, 0x1c, 0xd1, 0x44, 0x7e, 0x24, 0xdf,
+    0xb1, 0xca, 0xc8, 0xcb, 0xbb, 0xeb, 0x2f, 0x8d, 0xba, 0x47, 0xa1, 0x4d, 0x52, 0x1a, 0x91, 0xfa,
+    0xa9, 0xae, 0xfa, 0xfa, 0x7a, 0xba, 0xed, 0x73, 0x7b, 0x13, 0xd7, 0xb6, 0xd1, 0xe5, 0x03, 0x5e,
+    0x55, 0x73, 0xca, 0xa9, 0xf2, 0x76, 0x57, 0xe0, 0x57, 0x32, 0x2f, 0x5e, 0xd3, 0xe4, 0xb6, 0xd4,
+    0xaa, 0xc1, 0xed, 0xb3, 0x82, 0x65, 0xf0, 0x5f, 0x19, 0x04, 0x42, 0xea, 0x75, 0xf5, 0xe3, 0x41,
+    0x82, 0x1a, 0xaa, 0x91, 0x31, 0x58, 0xe8, 0x9e, 0xc3, 0x63, 0x54, 0xd0, 0x18, 0xbe, 0x4f, 0x4e,
+    0x72, 0x53, 0xa0, 0x30, 0xeb, 0x36, 0x5e, 0x54, 0xc0, 0x87, 0x34, 0x93, 0xd4, 0xea, 0xd0, 0xa8,
+    0x03, 0x94, 0xea, 0xe4, 0x8c, 0xb2, 0xad, 0x5b, 0xa2, 0xbe, 0xb9, 0xc1, 0x79, 0xa5, 0xab, 0x77,
+    0xbd, 0x40, 0x57, 0xd4, 0xeb, 0x3e, 0x6b, 0x78, 0xe6, 0x66, 0x00, 0xe1, 0xae, 0x7b, 0x9d, 0x6a,
+    0x00, 0xdb, 0x7e, 0xf7, 0xe2, 0x88, 0x0d, 0xc4, 0xc0, 0xf8, 0xfc, 0x8a, 0x46, 0x72, 0x7f, 0x10,
+    0x28, 0x1c, 0xc7, 0xe0, 0xeb, 0x8b, 0x15, 0x83, 0xa9, 0x25, 0xd3, 0x52, 0xbb, 0x5c, 0xff, 0x30,
+    0x60, 0x27, 0x25, 0x08, 0x22, 0xf3, 0x93, 0x40, 0x47, 0xff, 0x56, 0xf9, 0x3f, 0xed, 0x0e, 0xbd,
+    0x32, 0xc2, 0x14, 0x00, 0x00,
+};
+
+#endif
@@ -1,62 +1,191 @@
 // adafruit_io.cpp
 #include "adafruit_io.h"
+#include "events.h"
+#include <new>
 
-void setupAdafruitIO()
+// Gives the state machine single connect attempts and non-blocking polls
+// in place of the library's run(), which retries internally
+class IoClient : public AdafruitIO_WiFi
 {
-    if (config.useAdafruitIO) {
-        if (strlen(config.ioUsername) == 0 || strlen(config.ioKey) == 0) {
-            startLedPattern(LED_PATTERN_ERROR);
-            return;
+public:
+    using AdafruitIO_WiFi::AdafruitIO_WiFi;
+
+    // Adafruit_MQTT connect code: 0 connected, 4/5 credentials rejected
+    int8_t connectOnce()
+    {
+        _client->setTimeout(IO_CONNECT_TIMEOUT);
+        int8_t result = _mqtt->connect(_username, _key);
+        lastPing = millis();
+        return result;
+    }
+
+    // False once the connection is gone
+    bool poll()
+    {
+        if (!_mqtt->connected()) {
+            return false;
+        }
+        _mqtt->processPackets(0);
+        if (millis() - lastPing >= IO_PING_INTERVAL) {
+            lastPing = millis();
+            if (!_mqtt->ping()) {
+                _mqtt->disconnect();
+                return false;
+            }
         }
+        return true;
+    }
 
-        if (io)
-            delete io;
-        if (relayFeed)
-            delete relayFeed;
-        if (ipFeed)
-            delete ipFeed;
+private:
+    unsigned long lastPing = 0;
+};
 
-        startLedPattern(LED_PATTERN_IO_CONNECTING);
+// Constructed on first use; the object lives until the next reboot, and
+// config changes always reboot
+alignas(IoClient) static uint8_t ioStorage[sizeof(IoClient)];
+static IoClient* ioClient = nullptr;
+
+static IoState ioState = IO_STATE_DISABLED;
+static unsigned long stateSince = 0;
+static unsigned long backoffDelay = 0;
+static uint8_t failedAttempts = 0;
+IoStats ioStats = {0, 0};
+
+static void setIoState(IoState state)
+{
+    ioState = state;
+    stateSince = millis();
+}
+
+// Offline changes are caught up by onConnected()
+static void publishDeviceState(const Event& event)
+{
+    if (adafruitIOConnected() && relayFeed) {
+        relayFeed->save(deviceState ? 1 : 0);
+    }
+}
+
+void setupAdafruitIO()
+{
+    if (!config.useAdafruitIO || io) {
+        return;
+    }
+
+    if (strlen(config.ioUsername) == 0 || strlen(config.ioKey) == 0) {
+        startLedPattern(LED_PATTERN_ERROR);
+        return;
+    }
+
+    ioClient = new (ioStorage) IoClient(
+        config.ioUsername,
+        config.ioKey,
+        config.wifiSSID,
+        config.wifiPassword);
+    io = ioClient;
+
+    relayFeed = io->feed(config.relayFeedName);
+    ipFeed = io->feed(config.ipFeedName);
+
+    if (relayFeed) {
+        relayFeed->onMessage(handleRelayFeed);
+    }
+    subscribeEvents(EVENT_BIT(EVENT_DEVICE_STATE), publishDeviceState);
+
+    setIoState(IO_STATE_WAITING);
+}
+
+static void startBackoff()
+{
+    ioStats.failedConnects++;
+    if (failedAttempts < 16) {
+        failedAttempts++;
+    }
+    unsigned long ceiling = min<unsigned long>(IO_BACKOFF_MAX, (unsigned long)IO_BACKOFF_MIN << (failedAttempts - 1));
+    backoffDelay = ceiling / 2 + random(ceiling / 2 + 1);
+    setIoState(IO_STATE_BACKOFF);
+}
 
-        io = new AdafruitIO_WiFi(
-            config.ioUsername,
-            config.ioKey,
-            config.wifiSSID,
-            config.wifiPassword);
+static void onConnected()
+{
+    failedAttempts = 0;
+    ioStats.connects++;
+    setIoState(IO_STATE_CONNECTED);
+    startLedPattern(LED_PATTERN_SUCCESS);
 
-        relayFeed = io->feed(config.relayFeedName);
-        ipFeed = io->feed(config.ipFeedName);
+    // Catch the feeds up with anything that changed while offline
+    if (relayFeed) {
+        relayFeed->save(deviceState ? 1 : 0);
+    }
+    sendIPToAdafruitIO();
+}
 
-        if (relayFeed) {
-            relayFeed->onMessage(handleRelayFeed);
+void updateAdafruitIO()
+{
+    if (ioState == IO_STATE_DISABLED) {
+        return;
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        if (ioState != IO_STATE_WAITING) {
+            setIoState(IO_STATE_WAITING);
         }
+        return;
+    }
 
-        unsigned long connectStartTime = millis();
-        while (io->status() < AIO_CONNECTED) {
-            io->run();
-
-            if (millis() - connectStartTime > 10000) {
-                startLedPattern(LED_PATTERN_ERROR);
-                delete io;
-                io = nullptr;
-                relayFeed = nullptr;
-                ipFeed = nullptr;
-                return;
-            }
-            delay(500);
+    switch (ioState) {
+    case IO_STATE_DISABLED:
+        break;
+
+    case IO_STATE_WAITING:
+        startLedPattern(LED_PATTERN_IO_CONNECTING);
+        setIoState(IO_STATE_CONNECTING);
+        break;
+
+    case IO_STATE_CONNECTING: {
+        // One bounded attempt per pass; retries wait out the backoff
+        int8_t result = ioClient->connectOnce();
+        if (result == 0) {
+            onConnected();
+        } else if (result == 4 || result == 5) {
+            Serial.println("Adafruit IO rejected the credentials");
+            startLedPattern(LED_PATTERN_ERROR);
+            setIoState(IO_STATE_DISABLED);
+        } else {
+            startBackoff();
         }
+        break;
+    }
+
+    case IO_STATE_CONNECTED:
+        if (!ioClient->poll()) {
+            Serial.println("Adafruit IO connection lost");
+            startBackoff();
+        }
+        break;
 
-        startLedPattern(LED_PATTERN_SUCCESS);
+    case IO_STATE_BACKOFF:
+        if (millis() - stateSince >= backoffDelay) {
+            setIoState(IO_STATE_CONNECTING);
+        }
+        break;
     }
 }
 
+IoState getAdafruitIOState()
+{
+    return ioState;
+}
+
+bool adafruitIOConnected()
+{
+    return ioState == IO_STATE_CONNECTED;
+}
+
 void sendIPToAdafruitIO()
 {
-    if (config.useAdafruitIO && io && io->status() >= AIO_CONNECTED && ipFeed) {
-        if (WiFi.status() == WL_CONNECTED) {
-            String ipAddress = WiFi.localIP().toString();
-            ipFeed->save(ipAddress);
-        }
+    if (adafruitIOConnected() && ipFeed) {
+        String ipAddress = WiFi.localIP().toString();
+        ipFeed->save(ipAddress);
     }
 }
 
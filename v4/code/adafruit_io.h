@@ -7,7 +7,42 @@
 #include "device.h"
 #include <AdafruitIO_WiFi.h>
 
+// Background Adafruit IO connection
+// The client is built once into static storage and never freed.
+// updateAdafruitIO() runs from loop() and only touches the network while
+// WiFi is up. The library has no non-blocking connect, so instead of its
+// retrying run() loop each attempt is a single MQTT connect with the TLS
+// client's timeouts cut to IO_CONNECT_TIMEOUT. DNS, TCP, the TLS handshake
+// and the CONNACK wait are each bounded, but one attempt can still hold
+// loop() for a few seconds; failed attempts are therefore spaced with
+// exponential backoff and jitter between IO_BACKOFF_MIN and IO_BACKOFF_MAX.
+// While connected, polling reads pending packets without waiting and pings
+// every IO_PING_INTERVAL. Attempt times show up in the profiler's
+// adafruit_io stage.
+#define IO_CONNECT_TIMEOUT 2000
+#define IO_PING_INTERVAL 60000
+#define IO_BACKOFF_MIN 10000 // Above the library's 5 s reconnect throttle even after jitter
+#define IO_BACKOFF_MAX 300000
+
+enum IoState {
+    IO_STATE_DISABLED = 0,   // Not configured or credentials rejected
+    IO_STATE_WAITING = 1,    // WiFi down
+    IO_STATE_CONNECTING = 2,
+    IO_STATE_CONNECTED = 3,
+    IO_STATE_BACKOFF = 4
+};
+
+struct IoStats {
+    uint32_t connects;
+    uint32_t failedConnects;
+};
+
+extern IoStats ioStats;
+
 void setupAdafruitIO();
+void updateAdafruitIO();
+IoState getAdafruitIOState();
+bool adafruitIOConnected();
 void sendIPToAdafruitIO();
 void handleRelayFeed(AdafruitIO_Data* data);
 
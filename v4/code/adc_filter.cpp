@@ -0,0 +1,107 @@
+// adc_filter.cpp
+#include "adc_filter.h"
+
+struct AdcFilter {
+    uint8_t pin;
+    uint8_t filter;
+    bool configured;
+    bool ready;     // At least one value made it through the pipeline
+    bool emaPrimed;
+    uint16_t reads; // Raw reads summed into the current decimation block
+    uint32_t sum;
+    uint16_t window[ADC_MEDIAN_MAX];
+    uint8_t windowCount;
+    uint8_t windowNext;
+    int32_t ema;    // 16-bit value with ADC_EMA_FRACTION_BITS fraction bits
+    uint16_t output;
+};
+
+static AdcFilter filters[MAX_SENSORS];
+static uint8_t nextSlot = 0;
+
+// Median window length for the 2-bit median field: off, 3 or 5
+static uint8_t medianLength(uint8_t filter) {
+    static const uint8_t lengths[] = {1, 3, 5, 5};
+    return lengths[SENSOR_FILTER_MEDIAN(filter)];
+}
+
+static uint16_t median(const uint16_t* window, uint8_t count) {
+    uint16_t sorted[ADC_MEDIAN_MAX];
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t value = window[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+    return sorted[count / 2];
+}
+
+// One decimated 16-bit value through the median and EMA stages
+static void pushValue(AdcFilter& adc, uint16_t value) {
+    uint8_t length = medianLength(adc.filter);
+    if (length > 1) {
+        adc.window[adc.windowNext] = value;
+        adc.windowNext = (adc.windowNext + 1) % length;
+        if (adc.windowCount < length) {
+            adc.windowCount++;
+        }
+        value = median(adc.window, adc.windowCount);
+    }
+
+    uint8_t shift = SENSOR_FILTER_EMA(adc.filter);
+    if (shift > 0) {
+        int32_t scaled = static_cast<int32_t>(value) << ADC_EMA_FRACTION_BITS;
+        if (!adc.emaPrimed) {
+            adc.ema = scaled;
+            adc.emaPrimed = true;
+        } else {
+            adc.ema += (scaled - adc.ema) >> shift;
+        }
+        value = (adc.ema + (1 << (ADC_EMA_FRACTION_BITS - 1))) >> ADC_EMA_FRACTION_BITS;
+    }
+
+    adc.output = value;
+    adc.ready = true;
+}
+
+void adcFilterBegin(uint8_t slot, uint8_t pin, uint8_t filter) {
+    if (slot >= MAX_SENSORS) {
+        return;
+    }
+    AdcFilter& adc = filters[slot];
+    memset(&adc, 0, sizeof(adc));
+    adc.pin = pin;
+    adc.filter = filter;
+    adc.configured = true;
+}
+
+void adcSample() {
+    for (uint8_t tried = 0; tried < MAX_SENSORS; tried++) {
+        AdcFilter& adc = filters[nextSlot];
+        nextSlot = (nextSlot + 1) % MAX_SENSORS;
+        if (!adc.configured) {
+            continue;
+        }
+
+        adc.sum += analogRead(adc.pin);
+        uint8_t exponent = SENSOR_FILTER_OVERSAMPLE(adc.filter);
+        if (++adc.reads >= (1u << (2 * exponent))) {
+            // 4^n 10-bit reads sum to 10 + 2n bits; shift the rest of the way to 16
+            pushValue(adc, adc.sum << (6 - 2 * exponent));
+            adc.sum = 0;
+            adc.reads = 0;
+        }
+        return;
+    }
+}
+
+bool adcFilterRead(uint8_t slot, float& percent) {
+    if (slot >= MAX_SENSORS || !filters[slot].ready) {
+        return false;
+    }
+    // Full scale is ADC_MAX_READING shifted to 16 bits
+    percent = filters[slot].output * 100.0f / (ADC_MAX_READING << 6);
+    return true;
+}
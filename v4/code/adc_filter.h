@@ -0,0 +1,29 @@
+// adc_filter.h
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include "config.h"
+
+// Filter pipeline for analog sensors
+// adcSample() runs from the scheduler and takes a single analogRead() per
+// call, rotating over the analog sensors (the ESP8266 has one ADC, and
+// back-to-back reads starve the WiFi stack). Each sensor's raw reads go
+// through the stages selected by its SENSOR_FILTER() byte:
+//   oversampling  4^n reads are summed and decimated to one 16-bit value
+//   median        of the last 3 or 5 decimated values, drops spikes
+//   EMA           y += (x - y) / 2^n in fixed point, primed by the first value
+// readSensors() picks up the latest output with adcFilterRead().
+#define ADC_SAMPLE_INTERVAL 10
+#define ADC_MAX_READING 1023
+#define ADC_MEDIAN_MAX 5
+#define ADC_EMA_FRACTION_BITS 8
+
+#define SENSOR_FILTER_OVERSAMPLE(filter) ((filter) & 0x03)
+#define SENSOR_FILTER_MEDIAN(filter) (((filter) >> 2) & 0x03)
+#define SENSOR_FILTER_EMA(filter) (((filter) >> 4) & 0x07)
+
+void adcFilterBegin(uint8_t slot, uint8_t pin, uint8_t filter);
+void adcSample();
+bool adcFilterRead(uint8_t slot, float& percent);
+
+#endif
@@ -0,0 +1,193 @@
+// api.cpp
+#include "api.h"
+#include "commands.h"
+#include "device.h"
+#include "json_writer.h"
+#include "sensors.h"
+#include "history.h"
+#include "ws_protocol.h"
+#include <ArduinoJson.h>
+#include <uri/UriBraces.h>
+
+struct ApiCache {
+    bool valid;
+    uint32_t version;
+    size_t length;
+    char buffer[API_CACHE_SIZE];
+};
+
+ApiStats apiStats = {0, 0, 0};
+
+static ApiCache relaysCache;
+static ApiCache sensorsCache;
+static ApiCache statusCache;
+
+static void writeRelays(JsonWriter& json) {
+    uint8_t relayMask = getRelayMask();
+    json.beginObject().add("version", static_cast<unsigned long>(stateVersion)).beginArray("relays");
+    for (int i = 0; i < config.relayCount; i++) {
+        json.beginObject()
+            .add("index", i)
+            .add("pin", static_cast<int>(config.relayPins[i]))
+            .add("state", (relayMask & (1 << i)) != 0)
+            .endObject();
+    }
+    json.endArray().endObject();
+}
+
+static void writeSensors(JsonWriter& json) {
+    json.beginObject().add("version", static_cast<unsigned long>(stateVersion)).beginArray("sensors");
+    for (int i = 0; i < config.sensorCount; i++) {
+        float values[2];
+        if (getSensorValues(i, values) == 0) {
+            continue;
+        }
+        json.beginObject().add("index", i).add("type", static_cast<int>(config.sensors[i].type));
+        writeSensorValues(json, config.sensors[i].type, values);
+        json.endObject();
+    }
+    json.endArray().endObject();
+}
+
+static void writeStatus(JsonWriter& json) {
+    json.beginObject()
+        .add("state", deviceState ? "ON" : "OFF")
+        .add("version", static_cast<unsigned long>(stateVersion))
+        .add("boot", static_cast<unsigned long>(bootId))
+        .add("relayCount", static_cast<int>(config.relayCount))
+        .add("sensorCount", static_cast<int>(config.sensorCount))
+        .endObject();
+}
+
+// Serialize only when the state moved on since the cached copy
+static void sendCached(ApiCache& cache, void (*write)(JsonWriter&), uint32_t version = stateVersion) {
+    if (cache.valid && cache.version == version) {
+        apiStats.cacheHits++;
+    } else {
+        JsonWriter json(cache.buffer, sizeof(cache.buffer));
+        write(json);
+        cache.valid = !json.overflowed();
+        cache.version = version;
+        cache.length = json.length();
+    }
+
+    if (!cache.valid) {
+        server.send(500, "application/json", "{\"error\":\"response too large\"}");
+        return;
+    }
+    server.send(200, "application/json", cache.buffer, cache.length);
+}
+
+static void sendError(int code, const char* message) {
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject().add("error", message).endObject();
+    server.send(code, "application/json", json.c_str(), json.length());
+}
+
+static void sendCommandResult(const CommandResult& result) {
+    if (!result.ok) {
+        sendError(400, "invalid relay");
+        return;
+    }
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject().add("ok", true).add("version", static_cast<unsigned long>(result.version)).endObject();
+    server.send(200, "application/json", json.c_str(), json.length());
+}
+
+static int relayIndexArg() {
+    String arg = server.pathArg(0);
+    if (arg.length() == 0 || !isDigit(arg[0])) {
+        return -1;
+    }
+    int index = arg.toInt();
+    return index < config.relayCount ? index : -1;
+}
+
+static void timed(void (*handler)()) {
+    unsigned long start = micros();
+    handler();
+    apiStats.requests++;
+    apiStats.lastRequestMicros = micros() - start;
+}
+
+static void handleGetRelays() {
+    sendCached(relaysCache, writeRelays);
+}
+
+static void handlePutRelays() {
+    StaticJsonDocument<128> doc;
+    if (deserializeJson(doc, server.arg("plain"))) {
+        sendError(400, "invalid JSON");
+        return;
+    }
+    sendCommandResult(executeRelayCommand(COMMAND_SESSION_SHARED, doc.containsKey("id"), doc["id"], doc["mask"], doc["states"], wsNextSeq()));
+}
+
+static void handleGetRelay() {
+    int index = relayIndexArg();
+    if (index < 0) {
+        sendError(404, "no such relay");
+        return;
+    }
+
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject()
+        .add("index", index)
+        .add("pin", static_cast<int>(config.relayPins[index]))
+        .add("state", digitalRead(config.relayPins[index]) == LOW)
+        .add("version", static_cast<unsigned long>(stateVersion))
+        .endObject();
+    server.send(200, "application/json", json.c_str(), json.length());
+}
+
+static void handlePutRelay() {
+    int index = relayIndexArg();
+    if (index < 0) {
+        sendError(404, "no such relay");
+        return;
+    }
+
+    StaticJsonDocument<96> doc;
+    if (deserializeJson(doc, server.arg("plain")) || !doc.containsKey("state")) {
+        sendError(400, "expected {\"state\":true|false}");
+        return;
+    }
+
+    uint8_t mask = 1 << index;
+    bool state = doc["state"];
+    sendCommandResult(executeRelayCommand(COMMAND_SESSION_SHARED, doc.containsKey("id"), doc["id"], mask, state ? mask : 0, wsNextSeq()));
+}
+
+static void handleGetSensors() {
+    // Readings held back by the deadband change without a stateVersion
+    // bump; both counters only grow, so their sum moves with either
+    sendCached(sensorsCache, writeSensors, stateVersion + sensorSampleVersion);
+}
+
+static void handleGetStatus() {
+    sendCached(statusCache, writeStatus);
+}
+
+static void handleGetHistory() {
+    int sensor = server.hasArg("sensor") ? server.arg("sensor").toInt() : -1;
+    int tier = server.hasArg("tier") ? server.arg("tier").toInt() : 0;
+    if (sensor < 0 || sensor >= config.sensorCount || !historyAvailable(sensor)) {
+        sendError(404, "no such sensor");
+        return;
+    }
+    if (tier < 0 || tier >= HISTORY_TIERS) {
+        sendError(400, "invalid tier");
+        return;
+    }
+    streamHistory(sensor, tier);
+}
+
+void initApi() {
+    server.on("/api/relays", HTTP_GET, []() { timed(handleGetRelays); });
+    server.on("/api/relays", HTTP_PUT, []() { timed(handlePutRelays); });
+    server.on(UriBraces("/api/relays/{}"), HTTP_GET, []() { timed(handleGetRelay); });
+    server.on(UriBraces("/api/relays/{}"), HTTP_PUT, []() { timed(handlePutRelay); });
+    server.on("/api/sensors", HTTP_GET, []() { timed(handleGetSensors); });
+    server.on("/api/status", HTTP_GET, []() { timed(handleGetStatus); });
+    server.on("/api/history", HTTP_GET, []() { timed(handleGetHistory); });
+}
@@ -0,0 +1,29 @@
+// api.h
+#ifndef API_H
+#define API_H
+
+#include "config.h"
+
+// REST API
+//   GET /api/relays            all relay states
+//   PUT /api/relays            {"mask":m,"states":s[,"id":n]}
+//   GET /api/relays/{i}        one relay
+//   PUT /api/relays/{i}        {"state":b[,"id":n]}
+//   GET /api/sensors           latest sensor values
+//   GET /api/status            device state and version
+//   GET /api/history?sensor=i[&tier=t]  recent values, streamed (see history.h)
+// Collection responses are serialized once per stateVersion (sensors also
+// once per sampling cycle) and served from a cache until that changes.
+#define API_CACHE_SIZE 512
+
+struct ApiStats {
+    uint32_t requests;
+    uint32_t cacheHits;
+    uint32_t lastRequestMicros;
+};
+
+extern ApiStats apiStats;
+
+void initApi();
+
+#endif
@@ -0,0 +1,43 @@
+// chunked.cpp
+#include "chunked.h"
+#include <stdarg.h>
+
+static char chunkBuffer[CHUNK_BUFFER_SIZE];
+static size_t chunkLength = 0;
+
+static void flushChunk() {
+    if (chunkLength > 0) {
+        server.sendContent(chunkBuffer, chunkLength);
+        chunkLength = 0;
+    }
+}
+
+void beginChunked(int code, const char* contentType) {
+    chunkLength = 0;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+}
+
+void chunkPrintf(const char* format, ...) {
+    char line[CHUNK_LINE_MAX];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length <= 0) {
+        return;
+    }
+    length = min<int>(length, sizeof(line) - 1);
+
+    if (chunkLength + length > sizeof(chunkBuffer)) {
+        flushChunk();
+    }
+    memcpy(chunkBuffer + chunkLength, line, length);
+    chunkLength += length;
+}
+
+void endChunked() {
+    flushChunk();
+    server.sendContent("");
+}
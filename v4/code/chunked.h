@@ -0,0 +1,18 @@
+// chunked.h
+#ifndef CHUNKED_H
+#define CHUNKED_H
+
+#include "config.h"
+
+// Streamed HTTP responses
+// Output is collected in a small static buffer and sent as one chunk each
+// time it fills up, so long responses need no heap. Handlers run one at a
+// time, so a single buffer serves every streamed response.
+#define CHUNK_BUFFER_SIZE 256
+#define CHUNK_LINE_MAX 128 // Longest single chunkPrintf() output
+
+void beginChunked(int code, const char* contentType);
+void chunkPrintf(const char* format, ...);
+void endChunked();
+
+#endif
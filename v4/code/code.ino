@@ -6,19 +6,54 @@
 #include "sensors.h"
 #include "webserver.h"
 #include "adafruit_io.h"
+#include "persistence.h"
+#include "ws_protocol.h"
+#include "metrics.h"
+#include "sse.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "events.h"
 #include "UI.h"
 
+// Set once the station has connected and the servers are up
+static bool networkReady = false;
+
+// Runs from updateWiFi() on the first connection after boot
+static void startNetworkServices() {
+  setupMDNS();
+
+  // Connects in the background from updateAdafruitIO()
+  setupAdafruitIO();
+
+  // Initialize web server and WebSocket server
+  initWebServer();
+
+  // Periodic work, run from loop() by runScheduler()
+  scheduleEvery("mdns", MDNS_UPDATE_INTERVAL, updateMDNS);
+  scheduleEvery("sensors", SENSOR_UPDATE_INTERVAL, readSensors, SENSOR_UPDATE_INTERVAL);
+  if (config.useAdafruitIO) {
+    scheduleEvery("ip", IP_UPDATE_INTERVAL, sendIPToAdafruitIO, IP_UPDATE_INTERVAL);
+  }
+
+  networkReady = true;
+
+  // Don't call setDeviceState here since loadDeviceState already set everything up
+  broadcastStatus(deviceState); // Just broadcast the current state
+}
+
 void setup() {
   Serial.begin(115200);
   pinMode(LED_PIN, OUTPUT);
+  scheduleEvery("led", LED_UPDATE_INTERVAL, updateLedPattern);
+  initLedEvents();
+  initDeviceEvents();
+  initSensorEvents();
+#if LOOP_PROFILER
+  initProfiler();
+#endif
 
   loadConfig();
-
-  // Initialize relay pins
-  for (int i = 0; i < config.relayCount; i++) {
-    pinMode(config.relayPins[i], OUTPUT);
-    digitalWrite(config.relayPins[i], HIGH); // Initialize to OFF state initially
-  }
+  initRelayPins();
 
   // Load saved relay states - this will set deviceState and update relays
   loadDeviceState();
@@ -28,55 +63,46 @@ void setup() {
 
   WiFi.persistent(true);
   WiFi.setAutoConnect(true);
-  WiFi.setAutoReconnect(true);
-
-  bool wifiConnected = attemptWiFiConnection();
 
-  if (!wifiConnected) {
-    isSetupMode = true;
+  // Connects in the background; no SSID means straight to the portal
+  if (!startWiFi(startNetworkServices)) {
     startCaptivePortal();
     return;
   }
 
-  setupMDNS();
-
-  if (config.useAdafruitIO) {
-    setupAdafruitIO();
-  }
-
-  // Initialize web server and WebSocket server
-  initWebServer();
-
-  // Don't call setDeviceState here since loadDeviceState already set everything up
-  broadcastStatus(deviceState); // Just broadcast the current state
+  scheduleEvery("wifi", WIFI_STATE_INTERVAL, updateWiFi);
 }
 
 void loop() {
+  unsigned long loopStart = micros();
+  PROFILE_BEGIN();
+
   if (isSetupMode) {
     dnsServer.processNextRequest();
+    PROFILE_STAGE(PROFILE_DNS);
   }
 
   server.handleClient();
+  PROFILE_STAGE(PROFILE_HTTP);
+  handlePersistence();
+  PROFILE_STAGE(PROFILE_PERSISTENCE);
 
-  if (!isSetupMode) {
-    checkWiFiConnection();
+  if (networkReady) {
     webSocket.loop();
+    PROFILE_STAGE(PROFILE_WEBSOCKET);
+    wsServiceClients();
+    sseServiceStreams();
+    PROFILE_STAGE(PROFILE_STREAMS);
 
-    if (config.useAdafruitIO) {
-      io->run();
+    updateAdafruitIO();
+    PROFILE_STAGE(PROFILE_ADAFRUIT_IO);
+  }
 
-      if (millis() - lastIPUpdate > IP_UPDATE_INTERVAL) {
-        sendIPToAdafruitIO();
-        lastIPUpdate = millis();
-      }
-    }
+  dispatchEvents();
+  PROFILE_STAGE(PROFILE_EVENTS);
 
-    MDNS.update();
+  runScheduler();
+  PROFILE_STAGE(PROFILE_SCHEDULER);
 
-    // Read sensor data if it's time
-    if (millis() - lastSensorUpdate > SENSOR_UPDATE_INTERVAL) {
-      readSensors();
-      lastSensorUpdate = millis();
-    }
-  }
+  recordLoopTime(micros() - loopStart);
 }
\ No newline at end of file
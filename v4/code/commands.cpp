@@ -0,0 +1,123 @@
+// commands.cpp
+#include "commands.h"
+#include "device.h"
+
+struct CommandEntry {
+    uint32_t session;
+    uint32_t id;
+    CommandResult result;
+};
+
+struct RelayChange {
+    uint32_t version;
+    uint8_t changedMask;
+};
+
+uint32_t bootId = 0;
+CommandStats commandStats = {0, 0, 0};
+
+static CommandEntry commandHistory[COMMAND_HISTORY_SIZE];
+static uint8_t commandCount = 0;
+static uint8_t commandHead = 0;
+
+static RelayChange relayLog[RELAY_CHANGE_LOG_SIZE];
+static uint8_t relayLogCount = 0;
+static uint8_t relayLogHead = 0;
+static uint32_t relayLogFloor = 0; // Changes up to this version may have been evicted
+
+void initCommands() {
+    // Distinguishes version numbers of this boot from those of the last one
+    bootId = ESP.random();
+}
+
+bool findCommand(uint32_t session, uint32_t id, CommandResult& result) {
+    for (uint8_t i = 0; i < commandCount; i++) {
+        if (commandHistory[i].session == session && commandHistory[i].id == id) {
+            result = commandHistory[i].result;
+            return true;
+        }
+    }
+    return false;
+}
+
+void recordCommand(uint32_t session, uint32_t id, const CommandResult& result) {
+    commandHistory[commandHead].session = session;
+    commandHistory[commandHead].id = id;
+    commandHistory[commandHead].result = result;
+    commandHead = (commandHead + 1) % COMMAND_HISTORY_SIZE;
+    if (commandCount < COMMAND_HISTORY_SIZE) {
+        commandCount++;
+    }
+}
+
+void forgetCommands(uint32_t session) {
+    if (session == COMMAND_SESSION_SHARED) {
+        return;
+    }
+    for (uint8_t i = 0; i < commandCount; i++) {
+        if (commandHistory[i].session == session) {
+            commandHistory[i].session = COMMAND_SESSION_NONE;
+        }
+    }
+}
+
+// Switch the masked relays together; every client is told once from the
+// EVENT_RELAYS broadcast
+static bool applyRelayCommand(uint8_t mask, uint8_t states, uint16_t seq) {
+    mask &= (1 << config.relayCount) - 1;
+    if (mask == 0) {
+        return false;
+    }
+
+    setRelayMask(mask, states, seq);
+    return true;
+}
+
+// Shared by the WebSocket and REST paths; a known id returns the recorded
+// result without switching anything
+CommandResult executeRelayCommand(uint32_t session, bool hasId, uint32_t id, uint8_t mask, uint8_t states, uint16_t seq) {
+    CommandResult result;
+
+    if (hasId && findCommand(session, id, result)) {
+        commandStats.duplicates++;
+        return result;
+    }
+
+    result.ok = applyRelayCommand(mask, states, seq);
+    result.version = stateVersion;
+    if (result.ok) {
+        commandStats.applied++;
+    } else {
+        commandStats.rejected++;
+    }
+
+    if (hasId) {
+        recordCommand(session, id, result);
+    }
+    return result;
+}
+
+void recordRelayChange(uint8_t changedMask) {
+    if (relayLogCount == RELAY_CHANGE_LOG_SIZE) {
+        relayLogFloor = relayLog[relayLogHead].version;
+    } else {
+        relayLogCount++;
+    }
+    relayLog[relayLogHead].version = stateVersion;
+    relayLog[relayLogHead].changedMask = changedMask;
+    relayLogHead = (relayLogHead + 1) % RELAY_CHANGE_LOG_SIZE;
+}
+
+bool relayChangesSince(uint32_t version, uint8_t& changedMask) {
+    if (version < relayLogFloor || version > stateVersion) {
+        return false; // Too old for the log, or from another boot
+    }
+
+    changedMask = 0;
+    for (uint8_t i = 0; i < relayLogCount; i++) {
+        if (relayLog[i].version > version) {
+            changedMask |= relayLog[i].changedMask;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,44 @@
+// commands.h
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include "config.h"
+
+// Idempotent relay commands and resumable state
+// Commands carrying a client-supplied id are remembered in a small ring, so
+// a retried command is acknowledged again instead of being applied twice.
+// Ids chosen by REST and JSON clients share COMMAND_SESSION_SHARED and stay
+// valid across reconnects; binary commands are keyed by their frame seq,
+// which only means something within one connection, so they are recorded
+// under that connection's session and forgotten when it closes.
+// Relay changes are logged with the stateVersion they produced, so a client
+// reconnecting with the bootId and version it last saw only needs the
+// relays that changed since.
+#define COMMAND_HISTORY_SIZE 16
+#define RELAY_CHANGE_LOG_SIZE 16
+#define COMMAND_SESSION_SHARED 0
+#define COMMAND_SESSION_NONE 0xFFFFFFFF // Forgotten entries
+
+struct CommandResult {
+    bool ok;
+    uint32_t version;
+};
+
+struct CommandStats {
+    uint32_t applied;
+    uint32_t duplicates;
+    uint32_t rejected;
+};
+
+extern uint32_t bootId;
+extern CommandStats commandStats;
+
+void initCommands();
+bool findCommand(uint32_t session, uint32_t id, CommandResult& result);
+void recordCommand(uint32_t session, uint32_t id, const CommandResult& result);
+void forgetCommands(uint32_t session);
+CommandResult executeRelayCommand(uint32_t session, bool hasId, uint32_t id, uint8_t mask, uint8_t states, uint16_t seq);
+void recordRelayChange(uint8_t changedMask);
+bool relayChangesSince(uint32_t version, uint8_t& changedMask);
+
+#endif
@@ -1,33 +1,284 @@
 // config.cpp
 #include "config.h"
 #include "global.h"
+#include "persistence.h"
+#include "ws_protocol.h"
 
 // Global variable definitions
 DeviceConfig config;
 ESP8266WebServer server(80);
 DNSServer dnsServer;
-WebSocketsServer webSocket(81);
+WsServer webSocket(81, "", WS_BINARY_PROTOCOL);
 AdafruitIO_WiFi* io = nullptr;
 AdafruitIO_Feed* relayFeed = nullptr;
 AdafruitIO_Feed* ipFeed = nullptr;
 bool deviceState = false;
 bool isSetupMode = false;
-unsigned long lastSensorUpdate = 0;
-unsigned long lastIPUpdate = 0;
+uint32_t stateVersion = 0; // Bumped on every published relay, status or sensor change
+bool legacyConfigMigrated = false; // A legacy image was converted this boot
 
 void saveConfig() {
+  markConfigDirty(); // Written by handlePersistence() or flushPersistence()
+}
+
+// The packed image must leave the legacy relay bytes after the old struct intact
+static_assert(CONFIG_STORE_SIZE <= sizeof(LegacyDeviceConfig), "packed config overlaps legacy relay state");
+
+uint32_t crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static void putString(uint8_t* payload, size_t& pos, const char* value, size_t maxLength) {
+  size_t length = strnlen(value, maxLength - 1);
+  payload[pos++] = length;
+  memcpy(payload + pos, value, length);
+  pos += length;
+}
+
+static bool getString(const uint8_t* payload, size_t& pos, size_t end, char* value, size_t maxLength) {
+  if (pos >= end) return false;
+  size_t length = payload[pos++];
+  if (length >= maxLength || pos + length > end) return false;
+  memcpy(value, payload + pos, length);
+  value[length] = '\0';
+  pos += length;
+  return true;
+}
+
+static size_t encodeConfig(uint8_t* payload) {
+  size_t pos = 0;
+  putString(payload, pos, config.wifiSSID, sizeof(config.wifiSSID));
+  putString(payload, pos, config.wifiPassword, sizeof(config.wifiPassword));
+  putString(payload, pos, config.mdnsName, sizeof(config.mdnsName));
+  putString(payload, pos, config.ioUsername, sizeof(config.ioUsername));
+  putString(payload, pos, config.ioKey, sizeof(config.ioKey));
+  putString(payload, pos, config.relayFeedName, sizeof(config.relayFeedName));
+  putString(payload, pos, config.ipFeedName, sizeof(config.ipFeedName));
+
+  payload[pos++] = (config.useAdafruitIO ? 0x01 : 0) | (config.savedDeviceState ? 0x02 : 0);
+
+  payload[pos++] = config.relayCount;
+  for (int i = 0; i < config.relayCount; i++) {
+    payload[pos++] = config.relayPins[i];
+  }
+
+  payload[pos++] = config.sensorCount;
+  for (int i = 0; i < config.sensorCount; i++) {
+    payload[pos++] = config.sensors[i].type;
+    payload[pos++] = config.sensors[i].pin;
+    payload[pos++] = config.sensors[i].dhtType;
+    payload[pos++] = config.sensors[i].deadband;
+    payload[pos++] = (config.sensors[i].deadbandPercent ? 0x01 : 0) | (config.sensors[i].filter << 1);
+    payload[pos++] = config.sensors[i].maxSilence;
+  }
+  return pos;
+}
+
+static void setSensorDefaults(SensorConfig& sensor) {
+  sensor.deadband = SENSOR_DEFAULT_DEADBAND;
+  sensor.deadbandPercent = false;
+  sensor.maxSilence = SENSOR_DEFAULT_MAX_SILENCE;
+  sensor.filter = SENSOR_DEFAULT_FILTER;
+}
+
+static bool decodeConfig(const uint8_t* payload, size_t length, uint8_t schemaVersion) {
+  DeviceConfig decoded;
+  memset(&decoded, 0, sizeof(decoded));
+  size_t pos = 0;
+
+  if (!getString(payload, pos, length, decoded.wifiSSID, sizeof(decoded.wifiSSID)) ||
+      !getString(payload, pos, length, decoded.wifiPassword, sizeof(decoded.wifiPassword)) ||
+      !getString(payload, pos, length, decoded.mdnsName, sizeof(decoded.mdnsName)) ||
+      !getString(payload, pos, length, decoded.ioUsername, sizeof(decoded.ioUsername)) ||
+      !getString(payload, pos, length, decoded.ioKey, sizeof(decoded.ioKey)) ||
+      !getString(payload, pos, length, decoded.relayFeedName, sizeof(decoded.relayFeedName)) ||
+      !getString(payload, pos, length, decoded.ipFeedName, sizeof(decoded.ipFeedName))) {
+    return false;
+  }
+
+  if (pos + 2 > length) return false;
+  uint8_t flags = payload[pos++];
+  decoded.useAdafruitIO = flags & 0x01;
+  decoded.savedDeviceState = flags & 0x02;
+
+  decoded.relayCount = payload[pos++];
+  if (decoded.relayCount > MAX_RELAYS || pos + decoded.relayCount + 1 > length) return false;
+  for (int i = 0; i < decoded.relayCount; i++) {
+    decoded.relayPins[i] = payload[pos++];
+  }
+
+  decoded.sensorCount = payload[pos++];
+  // Schema 1 stored only type, pin and dhtType per sensor
+  size_t entrySize = schemaVersion == 1 ? CONFIG_SENSOR_ENTRY_SIZE_V1 : CONFIG_SENSOR_ENTRY_SIZE;
+  if (decoded.sensorCount > MAX_SENSORS || pos + decoded.sensorCount * entrySize != length) return false;
+  for (int i = 0; i < decoded.sensorCount; i++) {
+    uint8_t type = payload[pos++];
+    // Types from a newer firmware have no driver here; keep the slot but leave it off
+    decoded.sensors[i].type = type <= SENSOR_SOIL ? static_cast<SensorType>(type) : SENSOR_NONE;
+    decoded.sensors[i].pin = payload[pos++];
+    decoded.sensors[i].dhtType = payload[pos++];
+    setSensorDefaults(decoded.sensors[i]);
+    if (schemaVersion >= 2) {
+      decoded.sensors[i].deadband = payload[pos++];
+      uint8_t flags = payload[pos++];
+      decoded.sensors[i].deadbandPercent = flags & 0x01;
+      if (schemaVersion >= 3) {
+        decoded.sensors[i].filter = flags >> 1; // Unused bits before schema 3
+      }
+      decoded.sensors[i].maxSilence = payload[pos++];
+    }
+  }
+
+  decoded.configVersion = CONFIG_SCHEMA_VERSION;
+  config = decoded;
+  return true;
+}
+
+void migrateLegacyConfig(const LegacyDeviceConfig& legacy, LegacyFormat format) {
+  memset(&config, 0, sizeof(DeviceConfig));
+
+  // Legacy strings were strncpy'd and may lack a terminator
+  strncpy(config.wifiSSID, legacy.wifiSSID, sizeof(config.wifiSSID) - 1);
+  strncpy(config.wifiPassword, legacy.wifiPassword, sizeof(config.wifiPassword) - 1);
+  strncpy(config.mdnsName, legacy.mdnsName, sizeof(config.mdnsName) - 1);
+  strncpy(config.ioUsername, legacy.ioUsername, sizeof(config.ioUsername) - 1);
+  strncpy(config.ioKey, legacy.ioKey, sizeof(config.ioKey) - 1);
+  strncpy(config.relayFeedName, legacy.relayFeedName, sizeof(config.relayFeedName) - 1);
+  strncpy(config.ipFeedName, legacy.ipFeedName, sizeof(config.ipFeedName) - 1);
+  config.useAdafruitIO = legacy.useAdafruitIO;
+  config.savedDeviceState = legacy.savedDeviceState;
+  config.configVersion = CONFIG_SCHEMA_VERSION;
+
+  config.relayCount = min<uint8_t>(legacy.relayCount, MAX_RELAYS);
+  memcpy(config.relayPins, legacy.relayPins, config.relayCount);
+
+  config.sensorCount = 0;
+  for (int i = 0; i < min<uint8_t>(legacy.sensorCount, MAX_SENSORS); i++) {
+    SensorType type = static_cast<SensorType>(legacy.sensors[i].type);
+    if (format == LEGACY_V3) {
+      // v3: NONE, DHT, SOIL, WATER, LDR, LM35 - water and LM35 have no v4 driver
+      static const SensorType v3Types[] = {SENSOR_NONE, SENSOR_DHT, SENSOR_SOIL, SENSOR_NONE, SENSOR_LDR, SENSOR_NONE};
+      type = legacy.sensors[i].type >= 0 && legacy.sensors[i].type < 6 ? v3Types[legacy.sensors[i].type] : SENSOR_NONE;
+    } else if (format == LEGACY_AMBIGUOUS && type != SENSOR_DHT) {
+      // 2 and 3 are soil/water in v3 but LDR/soil in v4; leave them off
+      // rather than read the wrong sensor
+      if (type != SENSOR_NONE) {
+        Serial.printf("Legacy sensor %d has an ambiguous type and was disabled\n", i + 1);
+      }
+      type = SENSOR_NONE;
+    } else if (type > SENSOR_SOIL) {
+      type = SENSOR_NONE;
+    }
+    if (type == SENSOR_NONE) continue;
+
+    SensorConfig& sensor = config.sensors[config.sensorCount++];
+    sensor.type = type;
+    sensor.pin = legacy.sensors[i].pin;
+    sensor.dhtType = legacy.sensors[i].dhtType;
+    setSensorDefaults(sensor);
+  }
+}
+
+// v3 and v4 share the struct layout and version byte. v4 kept one 0/1 relay
+// state byte per relay after the struct; v3 never managed to write there,
+// so those bytes are still erased. Only v3 stored sensor types above SOIL (3).
+static LegacyFormat detectLegacyFormat(const LegacyDeviceConfig& legacy) {
+  uint8_t relayCount = min<uint8_t>(legacy.relayCount, MAX_RELAYS);
+  bool hasRelayBytes = relayCount > 0;
+  EEPROM.begin(sizeof(LegacyDeviceConfig) + relayCount);
+  for (int i = 0; i < relayCount; i++) {
+    if (EEPROM.read(CONFIG_ADDRESS + sizeof(LegacyDeviceConfig) + i) > 1) {
+      hasRelayBytes = false;
+    }
+  }
+  EEPROM.end();
+
+  if (hasRelayBytes) {
+    return LEGACY_V4;
+  }
+  for (int i = 0; i < min<uint8_t>(legacy.sensorCount, MAX_SENSORS); i++) {
+    if (legacy.sensors[i].type > SENSOR_SOIL) {
+      return LEGACY_V3;
+    }
+  }
+  return LEGACY_AMBIGUOUS;
+}
+
+static bool loadLegacyConfig() {
+  LegacyDeviceConfig legacy;
+  EEPROM.begin(sizeof(LegacyDeviceConfig));
+  EEPROM.get(CONFIG_ADDRESS, legacy);
+  EEPROM.end();
+
+  if (legacy.configVersion != LEGACY_CONFIG_VERSION) {
+    return false;
+  }
+
+  migrateLegacyConfig(legacy, detectLegacyFormat(legacy));
+  return true;
+}
+
+void commitConfig() {
   config.savedDeviceState = deviceState;
-  config.configVersion = 42;
-  EEPROM.begin(sizeof(DeviceConfig));
-  EEPROM.put(CONFIG_ADDRESS, config);
+  config.configVersion = CONFIG_SCHEMA_VERSION;
+
+  uint8_t image[CONFIG_STORE_SIZE];
+  ConfigHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = CONFIG_MAGIC;
+  header.schemaVersion = CONFIG_SCHEMA_VERSION;
+  header.length = encodeConfig(image + sizeof(ConfigHeader));
+  header.crc = crc32(image + sizeof(ConfigHeader), header.length);
+  memcpy(image, &header, sizeof(header));
+
+  // The EEPROM buffer only lives for the duration of the write
+  size_t imageSize = sizeof(ConfigHeader) + header.length;
+  EEPROM.begin(CONFIG_STORE_SIZE);
+  for (size_t i = 0; i < imageSize; i++) {
+    EEPROM.write(CONFIG_ADDRESS + i, image[i]);
+  }
   EEPROM.commit();
+  EEPROM.end();
 }
 
 void loadConfig() {
-  EEPROM.begin(sizeof(DeviceConfig));
-  EEPROM.get(CONFIG_ADDRESS, config);
+  uint8_t image[CONFIG_STORE_SIZE];
+  EEPROM.begin(CONFIG_STORE_SIZE);
+  for (size_t i = 0; i < CONFIG_STORE_SIZE; i++) {
+    image[i] = EEPROM.read(CONFIG_ADDRESS + i);
+  }
+  EEPROM.end();
+
+  ConfigHeader header;
+  memcpy(&header, image, sizeof(header));
+
+  bool valid = header.magic == CONFIG_MAGIC &&
+               header.schemaVersion >= 1 && header.schemaVersion <= CONFIG_SCHEMA_VERSION &&
+               header.length <= CONFIG_PAYLOAD_MAX &&
+               header.crc == crc32(image + sizeof(ConfigHeader), header.length) &&
+               decodeConfig(image + sizeof(ConfigHeader), header.length, header.schemaVersion);
+  if (valid) {
+    if (header.schemaVersion != CONFIG_SCHEMA_VERSION) {
+      saveConfig(); // Rewrite in the current schema
+    }
+  } else if (loadLegacyConfig()) {
+    // Also reached when the magic matched by chance but the rest did not
+    Serial.println(F("Migrated legacy config to packed format"));
+    legacyConfigMigrated = true;
+    saveConfig();
+    valid = true;
+  } else if (header.magic == CONFIG_MAGIC) {
+    Serial.println(F("Stored config failed CRC/validation, using defaults"));
+  }
 
-  if (config.configVersion != 42) {
+  if (!valid) {
     memset(&config, 0, sizeof(DeviceConfig));
     strcpy(config.mdnsName, "esp-device");
     strcpy(config.relayFeedName, "relay");
@@ -39,5 +290,5 @@ void loadConfig() {
     saveConfig();
   }
 
-  setDeviceState(config.savedDeviceState);
+  // Relay state is restored by loadDeviceState() once the relay pins are set up
 }
\ No newline at end of file
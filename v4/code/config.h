@@ -2,31 +2,42 @@
 #define CONFIG_H
 
 #include <AdafruitIO_WiFi.h>
-#include <DHT.h>
 #include <DNSServer.h>
 #include <EEPROM.h>
 #include <ESP8266WebServer.h>
 #include <ESP8266WiFi.h>
 #include <ESP8266mDNS.h>
-#include <WebSocketsServer.h>
+#include "ws_server.h"
 #include "led.h"
 
 // Device limits and intervals
 #define MAX_RELAYS 4
 #define MAX_SENSORS 6
 #define SENSOR_UPDATE_INTERVAL 5000
+#define SENSOR_DEFAULT_DEADBAND 0     // Any change is published
+#define SENSOR_DEFAULT_MAX_SILENCE 60 // Seconds between heartbeats
+
+// Analog filter, 7 bits: bits 0-1 oversampling exponent (1/4/16/64 reads
+// per output), bits 2-3 median window (off/3/5), bits 4-6 EMA shift (0 = off,
+// otherwise alpha = 1/2^n). Stored next to deadbandPercent in the sensor's
+// flags byte. See adc_filter.h.
+#define SENSOR_FILTER(oversample, median, ema) ((oversample) | ((median) << 2) | ((ema) << 4))
+#define SENSOR_DEFAULT_FILTER SENSOR_FILTER(2, 1, 2) // 16 reads, median of 3, alpha 1/4
 #define IP_UPDATE_INTERVAL (5 * 60 * 1000)
+#define MDNS_UPDATE_INTERVAL 100
+#define RESTART_DELAY 1000 // Lets the HTTP response go out before rebooting
 
 // WiFi and Network Constants
-#define WIFI_CONNECT_TIMEOUT 15000
-#define WIFI_RETRY_INTERVAL 30000
-#define MAX_WIFI_CONNECT_ATTEMPTS 5
+#define WIFI_CONNECT_TIMEOUT 15000 // Portal fallback if the first connection takes longer
 #define DNS_PORT 53
 
 // Device Constants
 #define RELAY_PIN 0
 #define LED_PIN 1
 #define CONFIG_ADDRESS 0
+#define CONFIG_MAGIC 0xC1C0 // Stored C0 C1: never valid UTF-8, so no legacy SSID starts with it
+#define CONFIG_SCHEMA_VERSION 3
+#define LEGACY_CONFIG_VERSION 42
 #define AP_SSID "ESP8266-Setup"
 #define AP_PASSWORD "configme123"
 
@@ -38,9 +49,7 @@ void initializeSensors();
 void readSensors();
 void setupMDNS();
 void setupAdafruitIO();
-void startCaptivePortal();
-bool attemptWiFiConnection();
-void checkWiFiConnection();
+void startCaptivePortal(bool keepStation);
 void sendIPToAdafruitIO();
 void broadcastStatus(bool state);
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length);
@@ -58,6 +67,10 @@ struct SensorConfig {
     SensorType type;
     uint8_t pin;
     uint8_t dhtType; // Only for DHT (11 or 22)
+    uint8_t deadband; // Tenths of a unit, or percent of the last value
+    bool deadbandPercent;
+    uint8_t maxSilence; // Seconds before an unchanged value is republished
+    uint8_t filter; // SENSOR_FILTER() pipeline for analog sensors
 };
 
 // Device Configuration
@@ -78,20 +91,71 @@ struct DeviceConfig {
     uint8_t sensorCount;
 };
 
+// Stored config header, followed by the packed, length-prefixed payload
+struct ConfigHeader {
+    uint16_t magic;
+    uint16_t length;
+    uint8_t schemaVersion;
+    uint8_t reserved[3];
+    uint32_t crc;
+};
+
+// Worst case payload: length-prefixed strings, flags, relays and sensors
+#define CONFIG_SENSOR_ENTRY_SIZE 6
+#define CONFIG_SENSOR_ENTRY_SIZE_V1 3
+#define CONFIG_PAYLOAD_MAX (7 + 31 + 63 + 31 + 31 + 63 + 31 + 31 + 1 + 1 + MAX_RELAYS + 1 + MAX_SENSORS * CONFIG_SENSOR_ENTRY_SIZE)
+#define CONFIG_STORE_SIZE (sizeof(ConfigHeader) + CONFIG_PAYLOAD_MAX)
+
+// Raw DeviceConfig layout written by v3 and v4 before the packed format.
+// Both used configVersion 42; v3 numbered sensor types differently.
+// Only v4 wrote relay state bytes (0/1) after the struct, and only v3 had
+// sensor types above SENSOR_SOIL; an image with neither is ambiguous.
+enum LegacyFormat {
+    LEGACY_V3,
+    LEGACY_V4,
+    LEGACY_AMBIGUOUS // Only DHT means the same in both
+};
+
+struct LegacySensorConfig {
+    int32_t type;
+    uint8_t pin;
+    uint8_t dhtType;
+};
+
+struct LegacyDeviceConfig {
+    char wifiSSID[32];
+    char wifiPassword[64];
+    char mdnsName[32];
+    bool useAdafruitIO;
+    char ioUsername[32];
+    char ioKey[64];
+    char relayFeedName[32];
+    char ipFeedName[32];
+    uint8_t configVersion;
+    bool savedDeviceState;
+    uint8_t relayPins[MAX_RELAYS];
+    LegacySensorConfig sensors[MAX_SENSORS];
+    uint8_t relayCount;
+    uint8_t sensorCount;
+};
+
 // External variables
 extern DeviceConfig config;
 extern ESP8266WebServer server;
 extern DNSServer dnsServer;
-extern WebSocketsServer webSocket;
+extern WsServer webSocket;
 extern AdafruitIO_WiFi* io;
 extern AdafruitIO_Feed* relayFeed;
 extern AdafruitIO_Feed* ipFeed;
 extern bool deviceState;
 extern bool isSetupMode;
-extern unsigned long lastSensorUpdate;
-extern unsigned long lastIPUpdate;
+extern uint32_t stateVersion;
+extern bool legacyConfigMigrated;
 
 void saveConfig();
+void commitConfig();
 void loadConfig();
+uint32_t crc32(const uint8_t* data, size_t length);
+void migrateLegacyConfig(const LegacyDeviceConfig& legacy, LegacyFormat format);
 
 #endif
\ No newline at end of file
@@ -1,54 +1,169 @@
 #include "device.h"
+#include "journal.h"
+#include "persistence.h"
+#include "rtc_state.h"
+#include "ws_protocol.h"
+#include "json_writer.h"
+#include "commands.h"
+#include "events.h"
+
+// Drive the masked relays in one write to the GPIO output register so they
+// all switch in the same instant. Relays are active LOW.
+static void writeRelayPins(uint8_t mask, uint8_t states) {
+  uint32_t affected = 0;
+  uint32_t high = 0;
+
+  for (int i = 0; i < config.relayCount; i++) {
+    if (!(mask & (1 << i))) continue;
+
+    uint8_t pin = config.relayPins[i];
+    bool level = !(states & (1 << i));
+    if (pin < 16) {
+      affected |= (1UL << pin);
+      if (level) high |= (1UL << pin);
+    } else {
+      digitalWrite(pin, level); // GPIO16 lives outside the GPO register
+    }
+  }
+
+  noInterrupts();
+  GPO = (GPO & ~affected) | high;
+  interrupts();
+
+  // Kept in step with the pins so a reset at any point restores this state
+  saveRtcRelayState(getRelayMask());
+}
+
+// Only the pins and the version change here; persistence and broadcasts
+// follow from dispatchEvents() in a later loop() pass
+void setRelayMask(uint8_t mask, uint8_t states, uint16_t seq) {
+  writeRelayPins(mask, states);
+  stateVersion++;
+  recordRelayChange(mask);
+  publishEvent(EVENT_RELAYS, mask, seq);
+}
 
 void setDeviceState(bool isOn) {
   deviceState = isOn;
-  for (int i = 0; i < config.relayCount; i++) {
-    digitalWrite(config.relayPins[i], isOn ? LOW : HIGH); // Toggle relay state
+  uint8_t allRelays = (1 << config.relayCount) - 1;
+  writeRelayPins(allRelays, isOn ? allRelays : 0);
+  stateVersion++;
+  recordRelayChange(allRelays);
+  publishEvent(EVENT_DEVICE_STATE, allRelays);
+}
+
+static void persistRelayEvent(const Event& event) {
+  saveDeviceState(deviceState);
+}
+
+static void broadcastRelayEvent(const Event& event) {
+  if (event.type == EVENT_DEVICE_STATE) {
+    broadcastStatus(deviceState);
   }
+  broadcastRelayStates(event.mask, event.seq ? event.seq : wsNextSeq());
+}
 
-  startLedPattern(isOn ? LED_PATTERN_ACTIVE : LED_PATTERN_IDLE);
+void initDeviceEvents() {
+  uint16_t relayEvents = EVENT_BIT(EVENT_RELAYS) | EVENT_BIT(EVENT_DEVICE_STATE);
+  subscribeEvents(relayEvents, persistRelayEvent);
+  subscribeEvents(relayEvents, broadcastRelayEvent);
+}
 
-  saveDeviceState(isOn);
-  broadcastStatus(isOn);
+// Warm reboot: the RTC mirror gives the relay levels, but only if it was
+// taken with the current relay pins; otherwise start OFF
+void initRelayPins() {
+  uint8_t rtcRelayMask = 0;
+  bool warmRestore = readRtcRelayState(rtcRelayMask);
 
-  if (config.useAdafruitIO && relayFeed) {
-    relayFeed->save(isOn ? 1 : 0);
+  // Latch each level before enabling the output so the pin never glitches
+  for (int i = 0; i < config.relayCount; i++) {
+    bool on = warmRestore && (rtcRelayMask & (1 << i));
+    digitalWrite(config.relayPins[i], on ? LOW : HIGH);
+    pinMode(config.relayPins[i], OUTPUT);
   }
 }
 
+uint8_t getRelayMask() {
+  uint8_t relayMask = 0;
+  for (int i = 0; i < config.relayCount; i++) {
+    if (digitalRead(config.relayPins[i]) == LOW) { // Get current relay state
+      relayMask |= (1 << i);
+    }
+  }
+  return relayMask;
+}
+
 void saveDeviceState(bool isOn) {
-  EEPROM.begin(sizeof(DeviceConfig) + config.relayCount); // Reserve space for relay states
-  EEPROM.put(CONFIG_ADDRESS, config); // Save device configuration
+  markStateDirty(); // Written to the journal by handlePersistence()
+}
+
+// Per-relay bytes the legacy firmware kept after its DeviceConfig. Only
+// meaningful on the boot that migrated that config: once the packed image
+// is committed the rest of the sector reads back as erased 0xFF.
+static uint8_t readLegacyRelayState() {
+  uint8_t relayMask = 0;
+  EEPROM.begin(sizeof(LegacyDeviceConfig) + config.relayCount);
   for (int i = 0; i < config.relayCount; i++) {
-    bool relayState = digitalRead(config.relayPins[i]) == LOW; // Get current relay state
-    EEPROM.put(CONFIG_ADDRESS + sizeof(DeviceConfig) + i, relayState); // Save relay state
+    if (EEPROM.read(CONFIG_ADDRESS + sizeof(LegacyDeviceConfig) + i) == 1) { // Anything but true is off
+      relayMask |= (1 << i);
+    }
   }
-  EEPROM.commit();
   EEPROM.end();
+  return relayMask;
 }
 
 void loadDeviceState() {
-  EEPROM.begin(sizeof(DeviceConfig) + config.relayCount); // Reserve space for relay states
-  EEPROM.get(CONFIG_ADDRESS, config); // Load device configuration
-  
-  // First relay state will determine the overall device state
-  bool firstRelayState;
-  EEPROM.get(CONFIG_ADDRESS + sizeof(DeviceConfig), firstRelayState);
-  deviceState = firstRelayState;
-  
-  for (int i = 0; i < config.relayCount; i++) {
-    bool relayState;
-    EEPROM.get(CONFIG_ADDRESS + sizeof(DeviceConfig) + i, relayState); // Load relay state
-    digitalWrite(config.relayPins[i], relayState ? LOW : HIGH); // Set relay state
+  // RTC memory on warm reboots, otherwise the flash journal
+  uint8_t relayMask = 0;
+  if (!readRtcRelayState(relayMask) && !journalRead(relayMask)) {
+    // Empty journal: all off, unless this boot just migrated a legacy config
+    relayMask = legacyConfigMigrated ? readLegacyRelayState() : 0;
+    journalAppend(relayMask);
   }
-  EEPROM.end();
-  
+
+  // First relay state will determine the overall device state
+  deviceState = relayMask & 0x01;
+
+  writeRelayPins((1 << config.relayCount) - 1, relayMask);
+
   // Update LED pattern based on restored state
   startLedPattern(deviceState ? LED_PATTERN_ACTIVE : LED_PATTERN_IDLE);
 }
 
+void broadcastRelayStates(uint8_t mask, uint16_t seq) {
+  // Catch-up events after a queue overflow carry EVENT_ALL_MASK
+  mask &= (1 << config.relayCount) - 1;
+  uint8_t relayMask = getRelayMask();
+  JsonWriter json(messageBuffer, sizeof(messageBuffer));
+
+  if (mask && !(mask & (mask - 1))) {
+    // Single relay - keep the per-relay message older clients understand
+    int index = 0;
+    while (!(mask & (1 << index))) index++;
+    json.beginObject()
+        .add("type", "relay")
+        .add("index", index)
+        .add("state", (relayMask & mask) != 0)
+        .add("version", static_cast<unsigned long>(stateVersion))
+        .endObject();
+  } else {
+    json.beginObject().add("type", "relays").beginArray("states");
+    for (int i = 0; i < config.relayCount; i++) {
+      json.add((relayMask & (1 << i)) != 0);
+    }
+    json.endArray().add("version", static_cast<unsigned long>(stateVersion)).endObject();
+  }
+
+  uint8_t frame[WS_FRAME_MAX_SIZE];
+  size_t frameLength = wsEncodeRelayState(frame, seq, config.relayCount, relayMask);
+  wsBroadcast(WS_TOPIC_RELAYS(mask), json.c_str(), json.length(), frame, frameLength);
+}
+
 void broadcastStatus(bool isOn) {
-  String status = isOn ? "ON" : "OFF";
-  String message = "{\"type\":\"status\",\"state\":\"" + status + "\"}";
-  webSocket.broadcastTXT(message);
+  JsonWriter json(messageBuffer, sizeof(messageBuffer));
+  json.beginObject().add("type", "status").add("state", isOn ? "ON" : "OFF").endObject();
+
+  uint8_t frame[WS_FRAME_MAX_SIZE];
+  size_t frameLength = wsEncodeStatus(frame, wsNextSeq(), isOn);
+  wsBroadcast(WS_TOPIC_STATUS, json.c_str(), json.length(), frame, frameLength);
 }
\ No newline at end of file
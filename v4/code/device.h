@@ -5,8 +5,13 @@
 #include "config.h"
 
 void setDeviceState(bool isOn);
+void setRelayMask(uint8_t mask, uint8_t states, uint16_t seq = 0);
 void saveDeviceState(bool isOn);
+uint8_t getRelayMask();
+void initRelayPins();
 void loadDeviceState();
+void broadcastRelayStates(uint8_t mask, uint16_t seq);
 void broadcastStatus(bool isOn);
+void initDeviceEvents();
 
 #endif
@@ -0,0 +1,134 @@
+// dht_async.cpp
+#include "dht_async.h"
+#include <Ticker.h>
+
+enum DhtState {
+    DHT_IDLE = 0,
+    DHT_START,    // Line held low by us
+    DHT_CAPTURE   // Released; the interrupt collects edges
+};
+
+struct DhtReader {
+    uint8_t pin;
+    uint8_t type;
+    bool configured;
+    volatile uint8_t state;
+    volatile uint8_t edgeCount;
+    volatile uint32_t edges[DHT_EDGE_COUNT];
+    uint32_t captureStart;
+    Ticker startTimer;
+};
+
+static DhtReader readers[MAX_SENSORS];
+static DhtCallback resultCallback = nullptr;
+
+static void IRAM_ATTR recordEdge(void* arg) {
+    DhtReader* reader = static_cast<DhtReader*>(arg);
+    uint8_t count = reader->edgeCount;
+    if (count < DHT_EDGE_COUNT) {
+        reader->edges[count] = micros();
+        reader->edgeCount = count + 1;
+    }
+}
+
+// Ticker context: end the start pulse and hand the line to the sensor
+static void releaseLine(DhtReader* reader) {
+    reader->edgeCount = 0;
+    reader->captureStart = micros();
+    pinMode(reader->pin, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(reader->pin), recordEdge, reader, FALLING);
+    reader->state = DHT_CAPTURE;
+}
+
+void dhtBegin(uint8_t slot, uint8_t pin, uint8_t type) {
+    if (slot >= MAX_SENSORS) {
+        return;
+    }
+    DhtReader& reader = readers[slot];
+    reader.pin = pin;
+    reader.type = type;
+    reader.configured = true;
+    reader.state = DHT_IDLE;
+    pinMode(pin, INPUT_PULLUP); // Idle high
+}
+
+void dhtOnResult(DhtCallback callback) {
+    resultCallback = callback;
+}
+
+bool dhtStartRead(uint8_t slot) {
+    if (slot >= MAX_SENSORS || !readers[slot].configured || readers[slot].state != DHT_IDLE) {
+        return false;
+    }
+
+    DhtReader& reader = readers[slot];
+    reader.state = DHT_START;
+    digitalWrite(reader.pin, LOW);
+    pinMode(reader.pin, OUTPUT);
+    reader.startTimer.once_ms(reader.type == 11 ? DHT11_START_MS : DHT22_START_MS, releaseLine, &reader);
+    return true;
+}
+
+// The last 41 falling edges frame the 40 data bits, so a response edge
+// missed while the interrupt was being attached does not matter
+bool dhtDecode(const uint32_t* edges, uint8_t count, uint8_t type, float& temperature, float& humidity) {
+    if (count < DHT_EDGE_COUNT - 1) {
+        return false;
+    }
+
+    const uint32_t* bitEdges = edges + count - (DHT_EDGE_COUNT - 1);
+    uint8_t data[5] = {0, 0, 0, 0, 0};
+    for (uint8_t bit = 0; bit < 40; bit++) {
+        data[bit / 8] <<= 1;
+        if (bitEdges[bit + 1] - bitEdges[bit] > DHT_BIT_THRESHOLD_US) {
+            data[bit / 8] |= 1;
+        }
+    }
+
+    if (static_cast<uint8_t>(data[0] + data[1] + data[2] + data[3]) != data[4]) {
+        return false;
+    }
+
+    if (type == 11) {
+        humidity = data[0] + data[1] * 0.1f;
+        temperature = data[2] + (data[3] & 0x7F) * 0.1f;
+        if (data[3] & 0x80) {
+            temperature = -temperature;
+        }
+    } else {
+        humidity = ((data[0] << 8) | data[1]) * 0.1f;
+        temperature = (((data[2] & 0x7F) << 8) | data[3]) * 0.1f;
+        if (data[2] & 0x80) {
+            temperature = -temperature;
+        }
+    }
+    return true;
+}
+
+void dhtPoll() {
+    for (uint8_t slot = 0; slot < MAX_SENSORS; slot++) {
+        DhtReader& reader = readers[slot];
+        if (reader.state != DHT_CAPTURE) {
+            continue;
+        }
+        if (reader.edgeCount < DHT_EDGE_COUNT && micros() - reader.captureStart < DHT_CAPTURE_TIMEOUT_US) {
+            continue;
+        }
+
+        detachInterrupt(digitalPinToInterrupt(reader.pin));
+
+        uint32_t edges[DHT_EDGE_COUNT];
+        uint8_t count = reader.edgeCount;
+        for (uint8_t i = 0; i < count; i++) {
+            edges[i] = reader.edges[i];
+        }
+        reader.state = DHT_IDLE;
+
+        float temperature = NAN;
+        float humidity = NAN;
+        bool ok = dhtDecode(edges, count, reader.type, temperature, humidity);
+        if (resultCallback) {
+            resultCallback(slot, ok, temperature, humidity);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+// dht_async.h
+#ifndef DHT_ASYNC_H
+#define DHT_ASYNC_H
+
+#include "config.h"
+
+// Interrupt-driven DHT11/21/22 driver
+// dhtStartRead() pulls the line low and returns; a Ticker releases it
+// after the start pulse and a pin interrupt timestamps every falling edge.
+// dhtPoll(), run from the scheduler, decodes the 40 bits once all edges
+// are in (or the transaction times out) and hands temperature and humidity
+// from the same transaction to the result callback. Nothing busy-waits and
+// interrupts stay enabled throughout.
+//
+// Bit timing: every bit is ~50 us low followed by ~27 us (0) or ~70 us (1)
+// high, so the gap between consecutive falling edges is ~77 us or ~120 us.
+#define DHT_POLL_INTERVAL 10
+#define DHT_EDGE_COUNT 42            // Response edge, then 41 edges framing 40 bits
+#define DHT_BIT_THRESHOLD_US 100     // Falling-edge gap above this is a 1
+#define DHT_CAPTURE_TIMEOUT_US 10000 // A full transaction takes ~5 ms
+#define DHT11_START_MS 20
+#define DHT22_START_MS 2
+
+typedef void (*DhtCallback)(uint8_t slot, bool ok, float temperature, float humidity);
+
+void dhtBegin(uint8_t slot, uint8_t pin, uint8_t type);
+void dhtOnResult(DhtCallback callback);
+bool dhtStartRead(uint8_t slot);
+void dhtPoll();
+bool dhtDecode(const uint32_t* edges, uint8_t count, uint8_t type, float& temperature, float& humidity);
+
+#endif
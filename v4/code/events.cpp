@@ -0,0 +1,71 @@
+// events.cpp
+#include "events.h"
+
+struct EventSubscriber {
+    uint16_t types;
+    EventHandler handler;
+};
+
+static Event eventQueue[EVENT_QUEUE_SIZE];
+static uint8_t eventHead = 0;  // Next event to dispatch
+static uint8_t eventCount = 0;
+static uint16_t overflowTypes = 0;
+static EventSubscriber subscribers[EVENT_MAX_SUBSCRIBERS];
+static uint8_t subscriberCount = 0;
+EventStats eventStats = {0, 0, 0, 0};
+
+bool subscribeEvents(uint16_t types, EventHandler handler) {
+    if (subscriberCount >= EVENT_MAX_SUBSCRIBERS) {
+        Serial.println("Event bus full, subscriber dropped");
+        return false;
+    }
+    subscribers[subscriberCount].types = types;
+    subscribers[subscriberCount].handler = handler;
+    subscriberCount++;
+    return true;
+}
+
+void publishEvent(EventType type, uint8_t mask, uint16_t seq) {
+    eventStats.published++;
+
+    if (eventCount == EVENT_QUEUE_SIZE) {
+        overflowTypes |= EVENT_BIT(type);
+        eventStats.coalesced++;
+        return;
+    }
+
+    Event& event = eventQueue[(eventHead + eventCount) % EVENT_QUEUE_SIZE];
+    event.type = type;
+    event.mask = mask;
+    event.seq = seq;
+    eventCount++;
+    eventStats.highWater = max(eventStats.highWater, eventCount);
+}
+
+static void deliver(const Event& event) {
+    for (uint8_t i = 0; i < subscriberCount; i++) {
+        if (subscribers[i].types & EVENT_BIT(event.type)) {
+            subscribers[i].handler(event);
+        }
+    }
+    eventStats.dispatched++;
+}
+
+void dispatchEvents() {
+    for (uint8_t budget = EVENT_DISPATCH_BUDGET; budget > 0; budget--) {
+        if (eventCount > 0) {
+            // Copy out first: a handler may publish and reuse the slot
+            Event event = eventQueue[eventHead];
+            eventHead = (eventHead + 1) % EVENT_QUEUE_SIZE;
+            eventCount--;
+            deliver(event);
+        } else if (overflowTypes != 0) {
+            uint8_t type = __builtin_ctz(overflowTypes);
+            overflowTypes &= ~EVENT_BIT(type);
+            Event event = {type, EVENT_ALL_MASK, 0};
+            deliver(event);
+        } else {
+            return;
+        }
+    }
+}
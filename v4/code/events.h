@@ -0,0 +1,51 @@
+// events.h
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <Arduino.h>
+
+// Internal event bus
+// State changes publish a small event into a fixed ring buffer and return
+// at once; dispatchEvents() hands queued events to the subscribers from a
+// later loop() slice, at most EVENT_DISPATCH_BUDGET per pass. Handlers
+// read the current state rather than trusting the event alone, so when
+// the queue is full the event is folded into one catch-up event of the
+// same type with every relay/sensor set in its mask.
+#define EVENT_QUEUE_SIZE 16
+#define EVENT_MAX_SUBSCRIBERS 8
+#define EVENT_DISPATCH_BUDGET 4
+
+enum EventType {
+    EVENT_RELAYS = 0,       // mask: relays switched, seq: frame sequence for the broadcast
+    EVENT_DEVICE_STATE = 1, // All relays switched together; see deviceState
+    EVENT_SENSORS = 2,      // mask: sensors with a new reading to broadcast
+    EVENT_WIFI_CONNECTED = 3,
+    EVENT_WIFI_LOST = 4,
+    EVENT_TYPE_COUNT
+};
+
+#define EVENT_BIT(type) ((uint16_t)1 << (type))
+#define EVENT_ALL_MASK 0xFF
+
+struct Event {
+    uint8_t type;
+    uint8_t mask;
+    uint16_t seq;
+};
+
+typedef void (*EventHandler)(const Event& event);
+
+struct EventStats {
+    uint32_t published;
+    uint32_t dispatched;
+    uint32_t coalesced; // Published while the queue was full
+    uint8_t highWater;
+};
+
+extern EventStats eventStats;
+
+bool subscribeEvents(uint16_t types, EventHandler handler);
+void publishEvent(EventType type, uint8_t mask = 0, uint16_t seq = 0);
+void dispatchEvents();
+
+#endif
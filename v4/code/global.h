@@ -3,20 +3,19 @@
 
 #include <ESP8266WebServer.h>
 #include <DNSServer.h>
-#include <WebSocketsServer.h>
+#include "ws_server.h"
 #include "AdafruitIO_WiFi.h"
 
 // External declarations for global variables
 extern DeviceConfig config;
 extern ESP8266WebServer server;
 extern DNSServer dnsServer;
-extern WebSocketsServer webSocket;
+extern WsServer webSocket;
 extern AdafruitIO_WiFi* io;
 extern AdafruitIO_Feed* relayFeed;
 extern AdafruitIO_Feed* ipFeed;
 extern bool deviceState;
 extern bool isSetupMode;
-extern unsigned long lastSensorUpdate;
-extern unsigned long lastIPUpdate;
+extern uint32_t stateVersion;
 
 #endif // GLOBAL_H
@@ -0,0 +1,175 @@
+// history.cpp
+#include "history.h"
+#include "sensors.h"
+#include "chunked.h"
+
+struct HistoryTier {
+    int16_t* samples;     // One value per entry in tier 0, min/avg/max after that
+    uint16_t capacity;    // Entries
+    uint16_t head;        // Next entry to write
+    uint16_t count;
+    uint16_t cycles;      // Sampling cycles in the entry being rolled up
+    uint16_t valid;       // ...of which had data
+    int32_t sum;
+    int16_t min;
+    int16_t max;
+};
+
+struct HistoryChannel {
+    uint8_t sensor;
+    uint8_t value;        // Index into getSensorValues()
+    HistoryTier tiers[HISTORY_TIERS];
+};
+
+static const uint16_t tierLengths[HISTORY_TIERS] = {HISTORY_TIER0_LENGTH, HISTORY_TIER1_LENGTH, HISTORY_TIER2_LENGTH};
+static const uint16_t tierFactors[HISTORY_TIERS] = {1, HISTORY_TIER1_FACTOR, HISTORY_TIER2_FACTOR};
+
+static int16_t historyPool[HISTORY_POOL_SIZE / sizeof(int16_t)];
+static HistoryChannel channels[MAX_SENSORS * 2];
+static uint8_t channelCount = 0;
+static unsigned long lastSampleTime = 0;
+
+static inline uint8_t entryWidth(uint8_t tier) {
+    return tier == 0 ? 1 : 3;
+}
+
+static int16_t toTenths(float value) {
+    if (isnan(value)) {
+        return HISTORY_NO_DATA;
+    }
+    return static_cast<int16_t>(constrain(lroundf(value * 10.0f), INT16_MIN + 1, INT16_MAX));
+}
+
+void initHistory() {
+    channelCount = 0;
+    for (int i = 0; i < config.sensorCount; i++) {
+        float values[2];
+        uint8_t count = getSensorValues(i, values);
+        for (uint8_t v = 0; v < count; v++) {
+            channels[channelCount].sensor = i;
+            channels[channelCount].value = v;
+            channelCount++;
+        }
+    }
+    if (channelCount == 0) {
+        return;
+    }
+
+    size_t wanted = 0;
+    for (uint8_t t = 0; t < HISTORY_TIERS; t++) {
+        wanted += tierLengths[t] * entryWidth(t);
+    }
+    size_t available = sizeof(historyPool) / sizeof(int16_t) / channelCount;
+
+    int16_t* next = historyPool;
+    for (uint8_t c = 0; c < channelCount; c++) {
+        for (uint8_t t = 0; t < HISTORY_TIERS; t++) {
+            HistoryTier& tier = channels[c].tiers[t];
+            tier = HistoryTier();
+            tier.capacity = wanted <= available ? tierLengths[t] : max<size_t>(1, tierLengths[t] * available / wanted);
+            tier.samples = next;
+            next += tier.capacity * entryWidth(t);
+        }
+    }
+}
+
+static void pushEntry(HistoryTier& tier, uint8_t width, const int16_t* entry) {
+    memcpy(tier.samples + tier.head * width, entry, width * sizeof(int16_t));
+    tier.head = (tier.head + 1) % tier.capacity;
+    if (tier.count < tier.capacity) {
+        tier.count++;
+    }
+}
+
+// Folds one sample into a rollup tier and closes the entry after
+// tierFactors[] cycles; cycles without data still count
+static void rollup(HistoryTier& tier, uint16_t factor, int16_t sample) {
+    if (sample != HISTORY_NO_DATA) {
+        if (tier.valid == 0 || sample < tier.min) tier.min = sample;
+        if (tier.valid == 0 || sample > tier.max) tier.max = sample;
+        tier.sum += sample;
+        tier.valid++;
+    }
+
+    if (++tier.cycles < factor) {
+        return;
+    }
+
+    int16_t entry[3] = {HISTORY_NO_DATA, HISTORY_NO_DATA, HISTORY_NO_DATA};
+    if (tier.valid > 0) {
+        entry[0] = tier.min;
+        entry[1] = static_cast<int16_t>(tier.sum / tier.valid);
+        entry[2] = tier.max;
+    }
+    pushEntry(tier, 3, entry);
+    tier.cycles = 0;
+    tier.valid = 0;
+    tier.sum = 0;
+}
+
+// Called once per sampling cycle, after all values are in
+void recordHistory() {
+    lastSampleTime = millis();
+
+    for (uint8_t c = 0; c < channelCount; c++) {
+        HistoryChannel& channel = channels[c];
+        float values[2];
+        getSensorValues(channel.sensor, values);
+        int16_t sample = toTenths(values[channel.value]);
+
+        pushEntry(channel.tiers[0], 1, &sample);
+        for (uint8_t t = 1; t < HISTORY_TIERS; t++) {
+            rollup(channel.tiers[t], tierFactors[t], sample);
+        }
+    }
+}
+
+bool historyAvailable(uint8_t sensorIndex) {
+    for (uint8_t c = 0; c < channelCount; c++) {
+        if (channels[c].sensor == sensorIndex) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// {"sensor":i,"tier":t,"interval":s,"age":s,"scale":10,
+//  "series":{"temperature":[v,...],...}}
+// Oldest first; rollup tiers give flat min,avg,max triples; null marks gaps
+void streamHistory(uint8_t sensorIndex, uint8_t tier) {
+    beginChunked(200, "application/json");
+    chunkPrintf("{\"sensor\":%u,\"tier\":%u,\"interval\":%lu,\"age\":%lu,\"scale\":10,\"series\":{",
+                sensorIndex, tier,
+                (unsigned long)tierFactors[tier] * SENSOR_UPDATE_INTERVAL / 1000,
+                (millis() - lastSampleTime) / 1000);
+
+    bool firstSeries = true;
+    for (uint8_t c = 0; c < channelCount; c++) {
+        HistoryChannel& channel = channels[c];
+        if (channel.sensor != sensorIndex) {
+            continue;
+        }
+
+        chunkPrintf("%s\"%s\":[", firstSeries ? "" : ",", sensorValueName(config.sensors[sensorIndex].type, channel.value));
+        firstSeries = false;
+
+        HistoryTier& ring = channel.tiers[tier];
+        uint8_t width = entryWidth(tier);
+        for (uint16_t k = 0; k < ring.count; k++) {
+            uint16_t index = (ring.head + ring.capacity - ring.count + k) % ring.capacity;
+            for (uint8_t w = 0; w < width; w++) {
+                int16_t value = ring.samples[index * width + w];
+                const char* separator = (k == 0 && w == 0) ? "" : ",";
+                if (value == HISTORY_NO_DATA) {
+                    chunkPrintf("%snull", separator);
+                } else {
+                    chunkPrintf("%s%d", separator, value);
+                }
+            }
+        }
+        chunkPrintf("]");
+    }
+
+    chunkPrintf("}}");
+    endChunked();
+}
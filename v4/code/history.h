@@ -0,0 +1,31 @@
+// history.h
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "config.h"
+
+// In-RAM sensor history
+// Every sampling cycle appends each sensor value, as signed 16-bit tenths,
+// to a per-value channel with HISTORY_TIERS ring buffers:
+//   tier 0  raw samples, one per SENSOR_UPDATE_INTERVAL
+//   tier 1  min/avg/max of HISTORY_TIER1_FACTOR raw samples
+//   tier 2  min/avg/max of HISTORY_TIER2_FACTOR raw samples
+// Rollups are accumulated incrementally, so nothing is re-scanned. All
+// rings are carved out of one static HISTORY_POOL_SIZE byte pool. When the
+// configured sensors need more than that, every tier is shortened by the
+// same factor.
+#define HISTORY_POOL_SIZE 4096
+#define HISTORY_TIERS 3
+#define HISTORY_TIER0_LENGTH 120 // 10 min at 5 s
+#define HISTORY_TIER1_FACTOR 12  // 1 min
+#define HISTORY_TIER1_LENGTH 360 // 6 h
+#define HISTORY_TIER2_FACTOR 180 // 15 min
+#define HISTORY_TIER2_LENGTH 288 // 3 days
+#define HISTORY_NO_DATA INT16_MIN
+
+void initHistory();
+void recordHistory();
+bool historyAvailable(uint8_t sensorIndex);
+void streamHistory(uint8_t sensorIndex, uint8_t tier);
+
+#endif
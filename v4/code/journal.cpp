@@ -0,0 +1,145 @@
+// journal.cpp
+#include "journal.h"
+
+extern "C" uint32_t _EEPROM_start;
+
+#define JOURNAL_RECORDS_PER_SECTOR (SPI_FLASH_SEC_SIZE / sizeof(JournalRecord))
+
+JournalStats journalStats = {0, 0, 0, 0};
+
+static uint32_t journalFirstSector = 0;
+static uint8_t activeSector = 0;     // Index into the reserved range
+static uint16_t nextSlot = 0;        // Next free record in the active sector
+static uint32_t lastSeq = 0;
+static uint8_t lastMask = 0;
+static bool hasRecord = false;
+static bool journalReady = false;
+
+static uint16_t journalCrc(const JournalRecord& record) {
+    // CRC-16/CCITT over everything but the crc field
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&record);
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < offsetof(JournalRecord, crc); i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t slotAddress(uint8_t sector, uint16_t slot) {
+    return (journalFirstSector + sector) * SPI_FLASH_SEC_SIZE + slot * sizeof(JournalRecord);
+}
+
+static bool isErased(const JournalRecord& record) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(&record);
+    return words[0] == 0xFFFFFFFF && words[1] == 0xFFFFFFFF;
+}
+
+static bool isValid(const JournalRecord& record) {
+    return record.magic == JOURNAL_RECORD_MAGIC && record.crc == journalCrc(record);
+}
+
+static bool writeRecord(uint8_t sector, uint16_t slot, uint8_t relayMask) {
+    JournalRecord record;
+    record.seq = lastSeq + 1;
+    record.magic = JOURNAL_RECORD_MAGIC;
+    record.relayMask = relayMask;
+    record.crc = journalCrc(record);
+
+    if (!ESP.flashWrite(slotAddress(sector, slot), reinterpret_cast<uint32_t*>(&record), sizeof(record))) {
+        return false;
+    }
+
+    lastSeq = record.seq;
+    lastMask = relayMask;
+    hasRecord = true;
+    return true;
+}
+
+void initJournal() {
+    uint32_t eepromSector = ((uint32_t)(uintptr_t)&_EEPROM_start - 0x40200000) / SPI_FLASH_SEC_SIZE;
+    journalFirstSector = eepromSector - JOURNAL_SECTOR_COUNT;
+
+    hasRecord = false;
+    lastSeq = 0;
+    activeSector = 0;
+    nextSlot = 0;
+
+    // Find the newest valid record and the first free slot after it
+    for (uint8_t sector = 0; sector < JOURNAL_SECTOR_COUNT; sector++) {
+        for (uint16_t slot = 0; slot < JOURNAL_RECORDS_PER_SECTOR; slot++) {
+            JournalRecord record;
+            ESP.flashRead(slotAddress(sector, slot), reinterpret_cast<uint32_t*>(&record), sizeof(record));
+
+            if (isErased(record)) {
+                break;
+            }
+            if (isValid(record) && (!hasRecord || record.seq > lastSeq)) {
+                lastSeq = record.seq;
+                lastMask = record.relayMask;
+                hasRecord = true;
+                activeSector = sector;
+                nextSlot = slot + 1;
+            }
+        }
+    }
+
+    // A torn or corrupt tail is skipped over, never overwritten in place
+    while (nextSlot < JOURNAL_RECORDS_PER_SECTOR) {
+        JournalRecord record;
+        ESP.flashRead(slotAddress(activeSector, nextSlot), reinterpret_cast<uint32_t*>(&record), sizeof(record));
+        if (isErased(record)) {
+            break;
+        }
+        nextSlot++;
+    }
+
+    journalReady = true;
+}
+
+bool journalRead(uint8_t& relayMask) {
+    if (!journalReady) {
+        initJournal();
+    }
+    if (!hasRecord) {
+        return false;
+    }
+    relayMask = lastMask;
+    return true;
+}
+
+bool journalAppend(uint8_t relayMask) {
+    if (!journalReady) {
+        initJournal();
+    }
+    if (hasRecord && relayMask == lastMask) {
+        journalStats.skipped++;
+        return true;
+    }
+
+    unsigned long start = micros();
+    bool ok;
+
+    if (nextSlot >= JOURNAL_RECORDS_PER_SECTOR) {
+        // Compact: the only live record is the newest one, so moving to the
+        // next sector just means erasing it and writing the current state
+        uint8_t sector = (activeSector + 1) % JOURNAL_SECTOR_COUNT;
+        ok = ESP.flashEraseSector(journalFirstSector + sector) && writeRecord(sector, 0, relayMask);
+        if (ok) {
+            activeSector = sector;
+            nextSlot = 1;
+            journalStats.compactions++;
+        }
+    } else {
+        ok = writeRecord(activeSector, nextSlot, relayMask);
+        nextSlot++;
+    }
+
+    if (ok) {
+        journalStats.appends++;
+    }
+    journalStats.lastWriteMicros = micros() - start;
+    return ok;
+}
@@ -0,0 +1,39 @@
+// journal.h
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <Arduino.h>
+
+// Relay state journal
+// Relay states are appended as small fixed-size records into a reserved
+// range of raw flash sectors instead of rewriting the EEPROM sector on every
+// toggle. The sectors sit directly below the EEPROM sector, so the flash
+// layout must not place a filesystem there (the default "FS: none" layout or
+// any layout with at least JOURNAL_SECTOR_COUNT spare sectors works).
+#define JOURNAL_SECTOR_COUNT 2
+#define JOURNAL_RECORD_MAGIC 0xA5
+
+// One journal entry, 8 bytes so it stays 4-byte aligned for flash writes
+struct JournalRecord {
+    uint32_t seq;
+    uint8_t magic;
+    uint8_t relayMask;
+    uint16_t crc;
+};
+
+struct JournalStats {
+    uint32_t appends;
+    uint32_t skipped;
+    uint32_t compactions;
+    uint32_t lastWriteMicros;
+};
+
+extern JournalStats journalStats;
+
+// The flash scan runs lazily on first use, so warm boots restored from RTC
+// memory don't pay for it before the relays are driven
+void initJournal();
+bool journalRead(uint8_t& relayMask);
+bool journalAppend(uint8_t relayMask);
+
+#endif
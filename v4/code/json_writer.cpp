@@ -0,0 +1,103 @@
+// json_writer.cpp
+#include "json_writer.h"
+#include <stdarg.h>
+
+char messageBuffer[MESSAGE_BUFFER_SIZE];
+
+JsonWriter::JsonWriter(char* buffer, size_t capacity)
+    : _buffer(buffer), _capacity(capacity), _length(0), _overflow(false), _needComma(false) {
+    _buffer[0] = '\0';
+}
+
+void JsonWriter::separator(const char* key) {
+    if (_needComma) {
+        append(",");
+    }
+    if (key) {
+        appendf("\"%s\":", key);
+    }
+    _needComma = true; // For whatever follows this value
+}
+
+void JsonWriter::append(const char* text) {
+    appendf("%s", text);
+}
+
+void JsonWriter::appendf(const char* format, ...) {
+    if (_overflow) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(_buffer + _length, _capacity - _length, format, args);
+    va_end(args);
+
+    if (written < 0 || _length + written >= _capacity) {
+        _overflow = true;
+        _buffer[_length] = '\0';
+        return;
+    }
+    _length += written;
+}
+
+JsonWriter& JsonWriter::beginObject(const char* key) {
+    separator(key);
+    append("{");
+    _needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    append("}");
+    _needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray(const char* key) {
+    separator(key);
+    append("[");
+    _needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    append("]");
+    _needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, const char* value) {
+    // Values are internal identifiers and never need escaping
+    separator(key);
+    appendf("\"%s\"", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, long value) {
+    separator(key);
+    appendf("%ld", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, unsigned long value) {
+    separator(key);
+    appendf("%lu", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, bool value) {
+    separator(key);
+    append(value ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, float value) {
+    separator(key);
+    if (isnan(value) || isinf(value)) {
+        append("null");
+    } else {
+        appendf("%.1f", value);
+    }
+    return *this;
+}
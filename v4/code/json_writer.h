@@ -0,0 +1,54 @@
+// json_writer.h
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+// Allocation-free JSON writer for outbound messages
+// Writes straight into a caller-supplied buffer; commas are inserted
+// automatically. If the buffer runs out the writer stops appending and
+// overflowed() reports it, so callers can drop the message.
+#define MESSAGE_BUFFER_SIZE 512
+
+// Shared by all outbound messages - each one is built and sent before the
+// next one starts, since everything runs from loop()
+extern char messageBuffer[MESSAGE_BUFFER_SIZE];
+
+class JsonWriter {
+public:
+    JsonWriter(char* buffer, size_t capacity);
+
+    JsonWriter& beginObject(const char* key = nullptr);
+    JsonWriter& endObject();
+    JsonWriter& beginArray(const char* key = nullptr);
+    JsonWriter& endArray();
+
+    JsonWriter& add(const char* key, const char* value);
+    JsonWriter& add(const char* key, long value);
+    JsonWriter& add(const char* key, int value) { return add(key, static_cast<long>(value)); }
+    JsonWriter& add(const char* key, unsigned long value);
+    JsonWriter& add(const char* key, bool value);
+    JsonWriter& add(const char* key, float value);
+
+    // Array elements
+    JsonWriter& add(bool value) { return add(nullptr, value); }
+    JsonWriter& add(long value) { return add(nullptr, value); }
+    JsonWriter& add(float value) { return add(nullptr, value); }
+
+    const char* c_str() const { return _buffer; }
+    size_t length() const { return _length; }
+    bool overflowed() const { return _overflow; }
+
+private:
+    void separator(const char* key);
+    void append(const char* text);
+    void appendf(const char* format, ...);
+
+    char* _buffer;
+    size_t _capacity;
+    size_t _length;
+    bool _overflow;
+    bool _needComma;
+};
+
+#endif
@@ -1,5 +1,6 @@
 // led.cpp
 #include "led.h"
+#include "events.h"
 
 unsigned long lastLedUpdate = 0;
 bool ledState = false;
@@ -129,4 +130,26 @@ void startLedPattern(LedPattern pattern)
             digitalWrite(LED_PIN, HIGH);
             break;
     }
-}
\ No newline at end of file
+}
+
+static void handleLedEvent(const Event& event)
+{
+    switch (event.type) {
+        case EVENT_DEVICE_STATE:
+            startLedPattern(deviceState ? LED_PATTERN_ACTIVE : LED_PATTERN_IDLE);
+            break;
+        case EVENT_WIFI_CONNECTED:
+            startLedPattern(LED_PATTERN_SUCCESS);
+            break;
+        case EVENT_WIFI_LOST:
+            startLedPattern(LED_PATTERN_ERROR);
+            break;
+        default:
+            break;
+    }
+}
+
+void initLedEvents()
+{
+    subscribeEvents(EVENT_BIT(EVENT_DEVICE_STATE) | EVENT_BIT(EVENT_WIFI_CONNECTED) | EVENT_BIT(EVENT_WIFI_LOST), handleLedEvent);
+}
@@ -24,6 +24,7 @@ enum LedPattern {
 #define QUICK_BLINK_INTERVAL 100
 #define SLOW_BLINK_INTERVAL 500
 #define ERROR_BLINK_INTERVAL 150
+#define LED_UPDATE_INTERVAL 20 // How often the scheduler advances the pattern
 
 // LED pattern blink counts
 #define SETUP_MODE_PATTERN 2
@@ -33,6 +34,7 @@ enum LedPattern {
 #define IO_CONNECTING_PATTERN 3
 
 void startLedPattern(LedPattern pattern);
+void initLedEvents();
 void updateLedPattern();
 void handleRepeatingPattern(int blinkCount);
 void handleSinglePattern(int blinkCount);
@@ -0,0 +1,158 @@
+// metrics.cpp
+#include "metrics.h"
+#include "commands.h"
+#include "journal.h"
+#include "persistence.h"
+#include "sensors.h"
+#include "sse.h"
+#include "scheduler.h"
+#include "adafruit_io.h"
+#include "profiler.h"
+#include "events.h"
+#include "wifi.h"
+#include "ws_protocol.h"
+#include "chunked.h"
+
+// Upper bounds in microseconds; the last bucket is +Inf
+static const uint32_t loopBucketBounds[LOOP_HISTOGRAM_BUCKETS - 1] = {100, 500, 1000, 5000, 10000, 50000, 100000};
+
+LoopStats loopStats;
+
+void recordLoopTime(uint32_t loopMicros) {
+    uint8_t bucket = 0;
+    while (bucket < LOOP_HISTOGRAM_BUCKETS - 1 && loopMicros > loopBucketBounds[bucket]) {
+        bucket++;
+    }
+    loopStats.buckets[bucket]++;
+    loopStats.count++;
+    loopStats.sumMicros += loopMicros;
+    if (loopMicros > loopStats.maxMicros) {
+        loopStats.maxMicros = loopMicros;
+    }
+}
+
+static void counter(const char* name, uint32_t value) {
+    chunkPrintf("# TYPE relayctl_%s counter\nrelayctl_%s %u\n", name, name, value);
+}
+
+static void gauge(const char* name, uint32_t value) {
+    chunkPrintf("# TYPE relayctl_%s gauge\nrelayctl_%s %u\n", name, name, value);
+}
+
+// One labelled series per scheduler task; field selects the value
+static void taskFamily(const char* name, const char* type, uint32_t SchedulerTask::*field) {
+    chunkPrintf("# TYPE relayctl_%s %s\n", name, type);
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        const SchedulerTask* task = getTask(i);
+        if (task != nullptr) {
+            chunkPrintf("relayctl_%s{task=\"%s\"} %u\n", name, task->name, task->*field);
+        }
+    }
+}
+
+#if LOOP_PROFILER
+// Histogram series for one profiled stage or task, labelled label="name"
+static void profileHistogram(const char* family, const char* label, const char* name, const ProfileStats& stats) {
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < PROFILE_BUCKETS - 1; i++) {
+        cumulative += stats.buckets[i];
+        chunkPrintf("relayctl_%s_bucket{%s=\"%s\",le=\"%u\"} %u\n", family, label, name, profileBucketBound(i), cumulative);
+    }
+    chunkPrintf("relayctl_%s_bucket{%s=\"%s\",le=\"+Inf\"} %u\n", family, label, name, stats.count);
+    chunkPrintf("relayctl_%s_sum{%s=\"%s\"} %.0f\n", family, label, name, (double)stats.totalMicros);
+    chunkPrintf("relayctl_%s_count{%s=\"%s\"} %u\n", family, label, name, stats.count);
+}
+
+static void profileMetrics() {
+    chunkPrintf("# TYPE relayctl_loop_stage_microseconds histogram\n");
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        profileHistogram("loop_stage_microseconds", "stage", profileStageNames[i], profileStages[i]);
+    }
+    chunkPrintf("# TYPE relayctl_loop_stage_min_microseconds gauge\n");
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        chunkPrintf("relayctl_loop_stage_min_microseconds{stage=\"%s\"} %u\n", profileStageNames[i], profileStages[i].minMicros);
+    }
+    chunkPrintf("# TYPE relayctl_loop_stage_max_microseconds gauge\n");
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        chunkPrintf("relayctl_loop_stage_max_microseconds{stage=\"%s\"} %u\n", profileStageNames[i], profileStages[i].maxMicros);
+    }
+
+    chunkPrintf("# TYPE relayctl_task_microseconds histogram\n");
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        const SchedulerTask* task = getTask(i);
+        if (task != nullptr) {
+            profileHistogram("task_microseconds", "task", task->name, profileTasks[i]);
+        }
+    }
+}
+#endif
+
+static void handleMetrics() {
+    beginChunked(200, "text/plain; version=0.0.4");
+
+    chunkPrintf("# TYPE relayctl_loop_duration_microseconds histogram\n");
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < LOOP_HISTOGRAM_BUCKETS - 1; i++) {
+        cumulative += loopStats.buckets[i];
+        chunkPrintf("relayctl_loop_duration_microseconds_bucket{le=\"%u\"} %u\n", loopBucketBounds[i], cumulative);
+    }
+    chunkPrintf("relayctl_loop_duration_microseconds_bucket{le=\"+Inf\"} %u\n", loopStats.count);
+    // Printed as a double: the ESP8266 printf has no 64-bit integer conversions
+    chunkPrintf("relayctl_loop_duration_microseconds_sum %.0f\n", (double)loopStats.sumMicros);
+    chunkPrintf("relayctl_loop_duration_microseconds_count %u\n", loopStats.count);
+    gauge("loop_duration_max_microseconds", loopStats.maxMicros);
+
+    taskFamily("task_runs_total", "counter", &SchedulerTask::runs);
+    taskFamily("task_missed_deadlines_total", "counter", &SchedulerTask::missedDeadlines);
+    taskFamily("task_run_microseconds_total", "counter", &SchedulerTask::totalMicros);
+    taskFamily("task_run_max_microseconds", "gauge", &SchedulerTask::maxMicros);
+#if LOOP_PROFILER
+    profileMetrics();
+#endif
+
+    counter("relay_commands_applied_total", commandStats.applied);
+    counter("relay_commands_duplicate_total", commandStats.duplicates);
+    counter("relay_commands_rejected_total", commandStats.rejected);
+
+    gauge("websocket_clients", webSocket.connectedClients());
+    counter("websocket_frames_sent_total", wsStats.framesSent);
+    counter("websocket_bytes_sent_total", wsStats.bytesSent);
+    counter("websocket_frames_dropped_total", wsStats.framesDropped);
+    counter("websocket_clients_evicted_total", wsStats.clientsEvicted);
+
+    gauge("sse_streams", sseStreamCount());
+    counter("sse_events_sent_total", sseStats.eventsSent);
+    counter("sse_events_dropped_total", sseStats.eventsDropped);
+    counter("sse_streams_rejected_total", sseStats.streamsRejected);
+
+    counter("events_published_total", eventStats.published);
+    counter("events_dispatched_total", eventStats.dispatched);
+    counter("events_coalesced_total", eventStats.coalesced);
+    gauge("event_queue_high_water", eventStats.highWater);
+
+    counter("config_commits_total", persistenceStats.configCommits);
+    counter("state_commits_total", persistenceStats.stateCommits);
+    counter("commits_avoided_total", persistenceStats.commitsAvoided);
+    counter("journal_appends_total", journalStats.appends);
+    counter("journal_compactions_total", journalStats.compactions);
+
+    counter("sensor_reads_total", sensorStats.reads);
+    counter("sensor_read_failures_total", sensorStats.readFailures);
+    counter("sensor_read_microseconds_total", sensorStats.readMicros);
+    gauge("sensor_read_max_microseconds", sensorStats.maxReadMicros);
+    counter("sensor_values_suppressed_total", sensorStats.valuesSuppressed);
+
+    gauge("heap_free_bytes", ESP.getFreeHeap());
+    gauge("heap_max_free_block_bytes", ESP.getMaxFreeBlockSize());
+    counter("wifi_reconnects_total", wifiReconnects);
+    gauge("wifi_state", getWiFiState());
+    gauge("adafruit_io_state", getAdafruitIOState());
+    counter("adafruit_io_connects_total", ioStats.connects);
+    counter("adafruit_io_failed_connects_total", ioStats.failedConnects);
+
+    endChunked();
+}
+
+void initMetrics() {
+    server.on("/metrics", HTTP_GET, handleMetrics);
+}
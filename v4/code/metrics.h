@@ -0,0 +1,24 @@
+// metrics.h
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "config.h"
+
+// Prometheus text endpoint at /metrics
+// Counters live in the owning modules' *Stats structs; this module only
+// adds the loop() time histogram and renders everything on request.
+#define LOOP_HISTOGRAM_BUCKETS 8
+
+struct LoopStats {
+    uint32_t buckets[LOOP_HISTOGRAM_BUCKETS]; // Cumulative counts are built on output
+    uint32_t count;
+    uint64_t sumMicros;
+    uint32_t maxMicros;
+};
+
+extern LoopStats loopStats;
+
+void recordLoopTime(uint32_t loopMicros);
+void initMetrics();
+
+#endif
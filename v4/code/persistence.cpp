@@ -0,0 +1,60 @@
+// persistence.cpp
+#include "persistence.h"
+#include "config.h"
+#include "device.h"
+#include "journal.h"
+
+PersistenceStats persistenceStats = {0, 0, 0};
+
+static bool configDirty = false;
+static bool stateDirty = false;
+static unsigned long firstDirtyTime = 0;
+static unsigned long lastChangeTime = 0;
+
+static void markDirty(bool& flag) {
+    unsigned long now = millis();
+
+    if (flag) {
+        // Already pending - this change rides along with the next commit
+        persistenceStats.commitsAvoided++;
+    }
+    if (!configDirty && !stateDirty) {
+        firstDirtyTime = now;
+    }
+
+    flag = true;
+    lastChangeTime = now;
+}
+
+void markConfigDirty() {
+    markDirty(configDirty);
+}
+
+void markStateDirty() {
+    markDirty(stateDirty);
+}
+
+void handlePersistence() {
+    if (!configDirty && !stateDirty) {
+        return;
+    }
+
+    unsigned long now = millis();
+    if (now - lastChangeTime >= PERSIST_QUIET_WINDOW || now - firstDirtyTime >= PERSIST_MAX_DELAY) {
+        flushPersistence();
+    }
+}
+
+void flushPersistence() {
+    if (configDirty) {
+        configDirty = false;
+        commitConfig();
+        persistenceStats.configCommits++;
+    }
+
+    if (stateDirty) {
+        stateDirty = false;
+        journalAppend(getRelayMask());
+        persistenceStats.stateCommits++;
+    }
+}
@@ -0,0 +1,28 @@
+// persistence.h
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include <Arduino.h>
+
+// Write-behind persistence
+// Config and relay state changes only mark themselves dirty; the actual
+// flash write happens from loop() once no further change arrived for
+// PERSIST_QUIET_WINDOW, or at the latest PERSIST_MAX_DELAY after the first
+// unsaved change. Restart paths must call flushPersistence() first.
+#define PERSIST_QUIET_WINDOW 2000
+#define PERSIST_MAX_DELAY 10000
+
+struct PersistenceStats {
+    uint32_t configCommits;
+    uint32_t stateCommits;
+    uint32_t commitsAvoided;
+};
+
+extern PersistenceStats persistenceStats;
+
+void markConfigDirty();
+void markStateDirty();
+void handlePersistence();
+void flushPersistence();
+
+#endif
@@ -0,0 +1,135 @@
+// profiler.cpp
+#include "profiler.h"
+
+#if LOOP_PROFILER
+
+#include "json_writer.h"
+#include "ws_protocol.h"
+
+ProfileStats profileStages[PROFILE_STAGE_COUNT];
+ProfileStats profileTasks[SCHEDULER_MAX_TASKS];
+const char* const profileStageNames[PROFILE_STAGE_COUNT] = {
+    "dns", "http", "persistence", "websocket", "streams", "adafruit_io", "events", "scheduler"
+};
+
+#define PROFILE_COMMAND_MAX 16
+static char serialCommand[PROFILE_COMMAND_MAX];
+static uint8_t serialCommandLength = 0;
+
+void profileRecord(ProfileStats& stats, uint32_t elapsed) {
+    // 31 - clz gives floor(log2); values below 16 us share bucket 0
+    uint8_t bucket = elapsed < 16 ? 0 : 31 - __builtin_clz(elapsed) - 3;
+    stats.buckets[min<uint8_t>(bucket, PROFILE_BUCKETS - 1)]++;
+    if (stats.count == 0 || elapsed < stats.minMicros) {
+        stats.minMicros = elapsed;
+    }
+    stats.maxMicros = max(stats.maxMicros, elapsed);
+    stats.totalMicros += elapsed;
+    stats.count++;
+}
+
+uint32_t profileStage(ProfileStage stage, uint32_t mark) {
+    uint32_t now = micros();
+    profileRecord(profileStages[stage], now - mark);
+    return now;
+}
+
+// Exclusive upper bound of a bucket in microseconds; 0 for the last one
+uint32_t profileBucketBound(uint8_t bucket) {
+    return bucket < PROFILE_BUCKETS - 1 ? (uint32_t)16 << bucket : 0;
+}
+
+void profileReset() {
+    memset(profileStages, 0, sizeof(profileStages));
+    memset(profileTasks, 0, sizeof(profileTasks));
+}
+
+static uint32_t averageMicros(const ProfileStats& stats) {
+    return stats.count ? static_cast<uint32_t>(stats.totalMicros / stats.count) : 0;
+}
+
+static void printStats(const char* name, const ProfileStats& stats) {
+    Serial.printf("%-12s %10u %8u %8u %8u\n", name, stats.count, stats.minMicros, averageMicros(stats), stats.maxMicros);
+}
+
+static void printProfile() {
+    Serial.printf("%-12s %10s %8s %8s %8s\n", "stage", "count", "min us", "avg us", "max us");
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        printStats(profileStageNames[i], profileStages[i]);
+    }
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        const SchedulerTask* task = getTask(i);
+        if (task != nullptr) {
+            printStats(task->name, profileTasks[i]);
+        }
+    }
+}
+
+// Reads Serial without blocking; "profile" prints, "profile reset" clears
+static void pollSerialCommands() {
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+        if (c != '\n' && c != '\r') {
+            if (serialCommandLength < PROFILE_COMMAND_MAX - 1) {
+                serialCommand[serialCommandLength++] = c;
+            }
+            continue;
+        }
+
+        serialCommand[serialCommandLength] = '\0';
+        if (strcmp(serialCommand, "profile") == 0) {
+            printProfile();
+        } else if (strcmp(serialCommand, "profile reset") == 0) {
+            profileReset();
+            Serial.println("Profile reset");
+        }
+        serialCommandLength = 0;
+    }
+}
+
+static void writeStats(JsonWriter& json, const char* name, const ProfileStats& stats) {
+    json.beginArray(name)
+        .add(static_cast<long>(stats.minMicros))
+        .add(static_cast<long>(averageMicros(stats)))
+        .add(static_cast<long>(stats.maxMicros))
+        .endArray();
+}
+
+static void sendProfile(JsonWriter& json) {
+    json.endObject().endObject();
+    if (!json.overflowed()) {
+        wsBroadcast(WS_TOPIC_DEBUG, json.c_str(), json.length(), nullptr, 0, true);
+    }
+}
+
+// Two messages so each fits messageBuffer:
+// {"type":"profile","stages":{"http":[min,avg,max],...}} and the same with "tasks"
+static void broadcastProfile() {
+    if (!wsHasSubscribers(WS_TOPIC_DEBUG)) {
+        return;
+    }
+
+    JsonWriter stages(messageBuffer, sizeof(messageBuffer));
+    stages.beginObject().add("type", "profile").beginObject("stages");
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        writeStats(stages, profileStageNames[i], profileStages[i]);
+    }
+    sendProfile(stages);
+
+    JsonWriter tasks(messageBuffer, sizeof(messageBuffer));
+    tasks.beginObject().add("type", "profile").beginObject("tasks");
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        const SchedulerTask* task = getTask(i);
+        if (task != nullptr) {
+            writeStats(tasks, task->name, profileTasks[i]);
+        }
+    }
+    sendProfile(tasks);
+}
+
+void initProfiler() {
+    scheduleEvery("serial", 100, pollSerialCommands);
+    scheduleEvery("profile", PROFILE_REPORT_INTERVAL, broadcastProfile, PROFILE_REPORT_INTERVAL);
+}
+
+#endif
@@ -0,0 +1,68 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+#include "scheduler.h"
+
+// Loop latency profiler
+// Times each stage of loop() and each scheduler task with micros() and
+// keeps count, min, max, total and a log2 histogram per entry in static
+// memory (about 1 KB). Results are printed by the "profile" Serial
+// command, exported on /metrics and sent every PROFILE_REPORT_INTERVAL to
+// WebSocket clients subscribed to the debug topic. Build with
+// LOOP_PROFILER 0 to compile all of it out.
+#ifndef LOOP_PROFILER
+#define LOOP_PROFILER 1
+#endif
+
+#define PROFILE_BUCKETS 16   // Bucket 0 is < 16 us, bucket k < 2^(k+4) us, the last is open-ended
+#define PROFILE_REPORT_INTERVAL 5000
+
+enum ProfileStage {
+    PROFILE_DNS = 0,
+    PROFILE_HTTP,
+    PROFILE_PERSISTENCE,
+    PROFILE_WEBSOCKET,
+    PROFILE_STREAMS,
+    PROFILE_ADAFRUIT_IO,
+    PROFILE_EVENTS,
+    PROFILE_SCHEDULER,
+    PROFILE_STAGE_COUNT
+};
+
+struct ProfileStats {
+    uint32_t count;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint64_t totalMicros;
+    uint32_t buckets[PROFILE_BUCKETS];
+};
+
+#if LOOP_PROFILER
+
+extern ProfileStats profileStages[PROFILE_STAGE_COUNT];
+extern ProfileStats profileTasks[SCHEDULER_MAX_TASKS];
+extern const char* const profileStageNames[PROFILE_STAGE_COUNT];
+
+void profileRecord(ProfileStats& stats, uint32_t elapsed);
+uint32_t profileStage(ProfileStage stage, uint32_t mark);
+uint32_t profileBucketBound(uint8_t bucket);
+void profileReset();
+void initProfiler();
+
+// PROFILE_BEGIN() starts the clock; each PROFILE_STAGE() charges the time
+// since the previous mark to a stage and restarts the clock
+#define PROFILE_BEGIN() uint32_t profileMark = micros()
+#define PROFILE_STAGE(stage) profileMark = profileStage(stage, profileMark)
+#define PROFILE_TASK(slot, elapsed) profileRecord(profileTasks[slot], elapsed)
+
+#else
+
+#define PROFILE_BEGIN()
+#define PROFILE_STAGE(stage)
+#define PROFILE_TASK(slot, elapsed)
+
+#endif
+
+#endif
@@ -0,0 +1,39 @@
+// rtc_state.cpp
+#include "rtc_state.h"
+
+static bool readRecord(RtcRelayState& state) {
+    if (!ESP.rtcUserMemoryRead(RTC_STATE_OFFSET, reinterpret_cast<uint32_t*>(&state), sizeof(state))) {
+        return false;
+    }
+    return state.magic == RTC_STATE_MAGIC &&
+           state.relayCount <= MAX_RELAYS &&
+           state.crc == crc32(reinterpret_cast<const uint8_t*>(&state), offsetof(RtcRelayState, crc));
+}
+
+void saveRtcRelayState(uint8_t relayMask) {
+    RtcRelayState state;
+    memset(&state, 0, sizeof(state));
+    state.magic = RTC_STATE_MAGIC;
+    state.relayCount = config.relayCount;
+    state.relayMask = relayMask;
+    memcpy(state.relayPins, config.relayPins, sizeof(state.relayPins));
+    state.crc = crc32(reinterpret_cast<const uint8_t*>(&state), offsetof(RtcRelayState, crc));
+
+    ESP.rtcUserMemoryWrite(RTC_STATE_OFFSET, reinterpret_cast<uint32_t*>(&state), sizeof(state));
+}
+
+bool readRtcRelayState(uint8_t& relayMask) {
+    RtcRelayState state;
+    if (!readRecord(state)) {
+        return false;
+    }
+
+    // Only trust the mirror if it describes the relays we are configured for
+    if (state.relayCount != config.relayCount ||
+        memcmp(state.relayPins, config.relayPins, config.relayCount) != 0) {
+        return false;
+    }
+
+    relayMask = state.relayMask;
+    return true;
+}
@@ -0,0 +1,29 @@
+// rtc_state.h
+#ifndef RTC_STATE_H
+#define RTC_STATE_H
+
+#include "config.h"
+
+// Relay state mirror in RTC user memory
+// RTC user memory survives ESP.restart() and watchdog resets but not power
+// loss, so a valid record means a warm reboot. It is rewritten on every
+// relay write and only trusted when it was taken with the relay count and
+// pins of the loaded config, so setup() can drive the relays right after
+// loading the config without touching the flash journal. Blocks below 32
+// are used by the OTA boot command.
+#define RTC_STATE_OFFSET 32
+#define RTC_STATE_MAGIC 0x52454C59 // "RELY"
+
+struct RtcRelayState {
+    uint32_t magic;
+    uint8_t relayCount;
+    uint8_t relayMask;
+    uint8_t relayPins[MAX_RELAYS];
+    uint8_t reserved[2];
+    uint32_t crc;
+};
+
+void saveRtcRelayState(uint8_t relayMask);
+bool readRtcRelayState(uint8_t& relayMask);
+
+#endif
@@ -0,0 +1,85 @@
+// scheduler.cpp
+#include "scheduler.h"
+#include "profiler.h"
+
+static SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+
+static inline bool isDue(uint32_t now, uint32_t due) {
+    return static_cast<int32_t>(now - due) >= 0;
+}
+
+static TaskId addTask(const char* name, uint32_t interval, uint32_t delay, TaskCallback callback) {
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        SchedulerTask& task = tasks[i];
+        if (task.active) {
+            continue;
+        }
+        task = SchedulerTask();
+        task.name = name;
+        task.callback = callback;
+        task.interval = interval;
+        task.due = millis() + delay;
+        task.active = true;
+#if LOOP_PROFILER
+        profileTasks[i] = ProfileStats();
+#endif
+        return i;
+    }
+    Serial.printf("Scheduler full, dropping task %s\n", name);
+    return -1;
+}
+
+TaskId scheduleEvery(const char* name, uint32_t interval, TaskCallback callback, uint32_t firstDelay) {
+    // An interval of 0 would make the task one-shot; run it every pass instead
+    return addTask(name, max<uint32_t>(interval, 1), firstDelay, callback);
+}
+
+TaskId scheduleOnce(const char* name, uint32_t delay, TaskCallback callback) {
+    return addTask(name, 0, delay, callback);
+}
+
+void cancelTask(TaskId id) {
+    if (id >= 0 && id < SCHEDULER_MAX_TASKS) {
+        tasks[id].active = false;
+    }
+}
+
+void runScheduler() {
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        SchedulerTask& task = tasks[i];
+        uint32_t now = millis();
+        if (!task.active || !isDue(now, task.due)) {
+            continue;
+        }
+
+        uint32_t late = now - task.due;
+        uint32_t slack = task.interval ? task.interval : SCHEDULER_ONESHOT_SLACK;
+        bool missed = late >= slack;
+        if (missed) {
+            task.missedDeadlines++;
+        }
+
+        // Reschedule before running so the callback may cancel itself
+        if (task.interval == 0) {
+            task.active = false;
+        } else {
+            task.due = missed ? now + task.interval : task.due + task.interval;
+        }
+
+        uint32_t start = micros();
+        task.callback();
+        uint32_t elapsed = micros() - start;
+
+        task.runs++;
+        task.totalMicros += elapsed;
+        task.maxMicros = max(task.maxMicros, elapsed);
+        PROFILE_TASK(i, elapsed);
+    }
+}
+
+const SchedulerTask* getTask(uint8_t index) {
+    if (index >= SCHEDULER_MAX_TASKS || tasks[index].name == nullptr) {
+        return nullptr;
+    }
+    return &tasks[index];
+}
@@ -0,0 +1,38 @@
+// scheduler.h
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// Cooperative task scheduler
+// Fixed task table run from loop(); tasks must return quickly. Due times
+// are kept as millis() values and compared by signed difference, so they
+// survive the 49-day rollover as long as intervals stay below 2^31 ms.
+// Periodic tasks keep their phase (next = due + interval); a task that
+// starts a full interval late counts a deadline miss and is rescheduled
+// from now instead of running back-to-back to catch up.
+#define SCHEDULER_MAX_TASKS 16 // 10 in use at boot; room for one-shots and new modules
+#define SCHEDULER_ONESHOT_SLACK 50 // ms a one-shot task may run late before it counts as a miss
+
+typedef void (*TaskCallback)();
+typedef int8_t TaskId; // -1 when the table is full
+
+struct SchedulerTask {
+    const char* name;
+    TaskCallback callback;
+    uint32_t interval; // 0 for one-shot tasks
+    uint32_t due;
+    bool active;
+    uint32_t runs;
+    uint32_t missedDeadlines;
+    uint32_t totalMicros;
+    uint32_t maxMicros;
+};
+
+TaskId scheduleEvery(const char* name, uint32_t interval, TaskCallback callback, uint32_t firstDelay = 0);
+TaskId scheduleOnce(const char* name, uint32_t delay, TaskCallback callback);
+void cancelTask(TaskId id);
+void runScheduler();
+const SchedulerTask* getTask(uint8_t index); // nullptr for unused slots
+
+#endif
@@ -1,28 +1,67 @@
 // sensors.cpp
 #include "sensors.h"
-#include <ArduinoJson.h>
-#include <WebSocketsServer.h>
+#include "ws_protocol.h"
+#include "json_writer.h"
+#include "events.h"
+#include "dht_async.h"
+#include "adc_filter.h"
+#include "scheduler.h"
+#include "history.h"
 
-extern WebSocketsServer webSocket;
-DHT* dhtSensors[MAX_SENSORS] = {nullptr};
 SensorData sensorData[MAX_SENSORS];
+SensorStats sensorStats = {0, 0, 0, 0, 0, 0, 0};
+uint32_t sensorSampleVersion = 0;
+
+// Reused for every batched frame so a sampling cycle allocates nothing
+static uint8_t sensorBinaryFrame[WS_SENSORS_FRAME_MAX_SIZE];
+
+// DHT reads still in flight this cycle; the batched frame waits for them
+static uint8_t dhtPending = 0;
+
+// Runs once per sampling cycle, after the last DHT result
+static void finishSensorCycle() {
+    sensorSampleVersion++;
+    recordHistory();
+#if SENSOR_BATCH_BROADCAST
+    publishEvent(EVENT_SENSORS, (1 << config.sensorCount) - 1);
+#endif
+}
+
+static void handleDhtResult(uint8_t sensorIndex, bool ok, float temperature, float humidity) {
+    if (ok) {
+        sensorData[sensorIndex].temperature = temperature;
+        sensorData[sensorIndex].humidity = humidity;
+    } else {
+        sensorStats.readFailures++;
+    }
+    
+#if !SENSOR_BATCH_BROADCAST
+    publishEvent(EVENT_SENSORS, 1 << sensorIndex);
+#endif
+    if (dhtPending > 0 && --dhtPending == 0) {
+        finishSensorCycle();
+    }
+}
 
 void initializeSensors() {
+    bool hasDht = false;
+    bool hasAnalog = false;
+    dhtOnResult(handleDhtResult);
+    
     for (int i = 0; i < config.sensorCount; i++) {
         SensorConfig& sensor = config.sensors[i];
         
         switch (sensor.type) {
             case SENSOR_DHT:
-                if (dhtSensors[i] != nullptr) {
-                    delete dhtSensors[i];
-                }
-                dhtSensors[i] = new DHT(sensor.pin, sensor.dhtType);
-                dhtSensors[i]->begin();
+                dhtBegin(i, sensor.pin, sensor.dhtType);
+                hasDht = true;
                 break;
                 
             case SENSOR_LDR:
             case SENSOR_SOIL:
                 pinMode(sensor.pin, INPUT);
+                adcFilterBegin(i, sensor.pin, sensor.filter);
+                hasAnalog = true;
                 break;
                 
             case SENSOR_NONE:
@@ -30,39 +69,69 @@ void initializeSensors() {
                 break;
         }
     }
+    
+    if (hasDht) {
+        scheduleEvery("dht", DHT_POLL_INTERVAL, dhtPoll);
+    }
+    if (hasAnalog) {
+        scheduleEvery("adc", ADC_SAMPLE_INTERVAL, adcSample);
+    }
+    initHistory();
+}
+
+// True if any value moved beyond the sensor's deadband or its heartbeat is due
+static bool shouldPublish(int sensorIndex, const float* values, uint8_t count) {
+    SensorConfig& sensor = config.sensors[sensorIndex];
+    SensorData& data = sensorData[sensorIndex];
+    
+    if (!data.published || millis() - data.lastPublishTime >= sensor.maxSilence * 1000UL) {
+        return true;
+    }
+    
+    for (uint8_t i = 0; i < count; i++) {
+        float threshold = sensor.deadbandPercent ? fabsf(data.lastPublished[i]) * sensor.deadband / 100.0f
+                                                 : sensor.deadband / 10.0f;
+        if (fabsf(values[i] - data.lastPublished[i]) > threshold) {
+            return true;
+        }
+    }
+    
+    sensorStats.valuesSuppressed++;
+    return false;
 }
 
+static void markPublished(int sensorIndex, const float* values, uint8_t count) {
+    SensorData& data = sensorData[sensorIndex];
+    for (uint8_t i = 0; i < count; i++) {
+        data.lastPublished[i] = values[i];
+    }
+    data.lastPublishTime = millis();
+    data.published = true;
+    stateVersion++;
+}
+
+// Starts the DHT transactions and takes the latest filtered analog values;
+// DHT values arrive through handleDhtResult() a few milliseconds later
 void readSensors() {
+    dhtPending = 0;
+    
     for (int i = 0; i < config.sensorCount; i++) {
         SensorConfig& sensor = config.sensors[i];
+        unsigned long readStart = micros();
         
         switch (sensor.type) {
             case SENSOR_DHT:
-                if (dhtSensors[i] != nullptr) {
-                    float temp = dhtSensors[i]->readTemperature();
-                    float humidity = dhtSensors[i]->readHumidity();
-                    
-                    if (!isnan(temp)) {
-                        sensorData[i].temperature = temp;
-                    }
-                    if (!isnan(humidity)) {
-                        sensorData[i].humidity = humidity;
-                    }
+                if (dhtStartRead(i)) {
+                    dhtPending++;
                 }
                 break;
                 
             case SENSOR_LDR:
-                {
-                    int rawValue = analogRead(sensor.pin);
-                    sensorData[i].light = map(rawValue, 0, 1023, 0, 100);
-                }
+                adcFilterRead(i, sensorData[i].light);
                 break;
                 
             case SENSOR_SOIL:
-                {
-                    int rawValue = analogRead(sensor.pin);
-                    sensorData[i].moisture = map(rawValue, 0, 1023, 0, 100);
-                }
+                adcFilterRead(i, sensorData[i].moisture);
                 break;
                 
             case SENSOR_NONE:
@@ -70,39 +139,166 @@ void readSensors() {
                 break;
         }
         
-        broadcastSensorData(i);
+        uint32_t readMicros = micros() - readStart;
+        sensorStats.reads++;
+        sensorStats.readMicros += readMicros;
+        sensorStats.maxReadMicros = max(sensorStats.maxReadMicros, readMicros);
+        
+#if !SENSOR_BATCH_BROADCAST
+        if (sensor.type != SENSOR_DHT) {
+            publishEvent(EVENT_SENSORS, 1 << i);
+        }
+#endif
+    }
+
+    if (dhtPending == 0) {
+        finishSensorCycle();
     }
 }
 
-void broadcastSensorData(int sensorIndex) {
-    if (sensorIndex >= config.sensorCount) return;
-    
-    StaticJsonDocument<200> doc;
-    SensorConfig& sensor = config.sensors[sensorIndex];
-    
-    doc["sensor"] = sensorIndex;
-    doc["type"] = static_cast<int>(sensor.type);
-    
-    switch (sensor.type) {
+// Current values of a sensor in wire order; 0 for unconfigured sensors
+uint8_t getSensorValues(int sensorIndex, float* values) {
+    switch (config.sensors[sensorIndex].type) {
         case SENSOR_DHT:
-            doc["temperature"] = sensorData[sensorIndex].temperature;
-            doc["humidity"] = sensorData[sensorIndex].humidity;
-            break;
+            values[0] = sensorData[sensorIndex].temperature;
+            values[1] = sensorData[sensorIndex].humidity;
+            return 2;
             
         case SENSOR_LDR:
-            doc["light"] = sensorData[sensorIndex].light;
-            break;
+            values[0] = sensorData[sensorIndex].light;
+            return 1;
             
         case SENSOR_SOIL:
-            doc["moisture"] = sensorData[sensorIndex].moisture;
-            break;
+            values[0] = sensorData[sensorIndex].moisture;
+            return 1;
             
         case SENSOR_NONE:
         default:
-            return;
+            return 0;
+    }
+}
+
+// JSON key of a value in getSensorValues() order
+const char* sensorValueName(SensorType type, uint8_t index) {
+    switch (type) {
+        case SENSOR_DHT:
+            return index == 0 ? "temperature" : "humidity";
+        case SENSOR_LDR:
+            return "light";
+        case SENSOR_SOIL:
+            return "moisture";
+        default:
+            return "value";
+    }
+}
+
+void writeSensorValues(JsonWriter& json, SensorType type, const float* values) {
+    switch (type) {
+        case SENSOR_DHT:
+            json.add("temperature", values[0]).add("humidity", values[1]);
+            break;
+        case SENSOR_LDR:
+            json.add("light", values[0]);
+            break;
+        case SENSOR_SOIL:
+            json.add("moisture", values[0]);
+            break;
+        default:
+            break;
+    }
+}
+
+static void broadcastSensorMessage(WsTopics topics, const JsonWriter& json, const uint8_t* frame, size_t frameLength) {
+    WsStats before = wsStats;
+    wsBroadcast(topics, json.c_str(), json.length(), frame, frameLength, true);
+    sensorStats.framesSent += wsStats.framesSent - before.framesSent;
+    sensorStats.bytesSent += wsStats.bytesSent - before.bytesSent;
+}
+
+void broadcastSensorData(int sensorIndex) {
+    if (sensorIndex >= config.sensorCount) return;
+    
+    SensorConfig& sensor = config.sensors[sensorIndex];
+    float values[2];
+    uint8_t valueCount = getSensorValues(sensorIndex, values);
+    
+    if (valueCount == 0 || !shouldPublish(sensorIndex, values, valueCount)) {
+        return;
+    }
+    
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject().add("sensor", sensorIndex).add("type", static_cast<int>(sensor.type));
+    writeSensorValues(json, sensor.type, values);
+    json.endObject();
+    if (json.overflowed()) {
+        return;
+    }
+    markPublished(sensorIndex, values, valueCount);
+    
+    uint8_t frame[WS_FRAME_MAX_SIZE];
+    size_t frameLength = wsEncodeSensor(frame, wsNextSeq(), sensorIndex, sensor.type, values, valueCount);
+    broadcastSensorMessage(WS_TOPIC_SENSOR(sensorIndex), json, frame, frameLength);
+}
+
+void broadcastSensorFrame() {
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject().add("type", "sensors").beginArray("sensors");
+    
+    size_t binaryLength = wsEncodeSensorsHeader(sensorBinaryFrame, wsNextSeq(), 0);
+    uint8_t entries = 0;
+    WsTopics topics = 0;
+    
+    for (int i = 0; i < config.sensorCount; i++) {
+        SensorConfig& sensor = config.sensors[i];
+        float values[2];
+        uint8_t valueCount = getSensorValues(i, values);
+        
+        if (valueCount == 0 || !shouldPublish(i, values, valueCount)) {
+            continue;
+        }
+        
+        json.beginObject().add("index", i).add("type", static_cast<int>(sensor.type));
+        writeSensorValues(json, sensor.type, values);
+        json.endObject();
+        
+        topics |= WS_TOPIC_SENSOR(i);
+        binaryLength = wsAppendSensor(sensorBinaryFrame, binaryLength, i, sensor.type, values, valueCount);
+        entries++;
+    }
+    
+    json.endArray().endObject();
+    if (entries == 0 || json.overflowed()) {
+        return;
+    }
+    sensorBinaryFrame[WS_FRAME_HEADER_SIZE] = entries;
+    
+    // Only now that the frame goes out; a dropped frame leaves the values
+    // due for the next cycle
+    for (int i = 0; i < config.sensorCount; i++) {
+        if (topics & WS_TOPIC_SENSOR(i)) {
+            float values[2];
+            markPublished(i, values, getSensorValues(i, values));
+        }
     }
     
-    String output;
-    serializeJson(doc, output);
-    webSocket.broadcastTXT(output);
+    // Clients subscribed to any sensor in the frame get the whole frame
+    broadcastSensorMessage(topics, json, sensorBinaryFrame, binaryLength);
+}
+
+// Sampling only stores readings; the deadband check and the fan-out to
+// clients run from dispatchEvents() in a later loop() pass
+static void broadcastSensorEvent(const Event& event) {
+#if SENSOR_BATCH_BROADCAST
+    broadcastSensorFrame();
+#else
+    for (int i = 0; i < config.sensorCount; i++) {
+        if (event.mask & (1 << i)) {
+            broadcastSensorData(i);
+        }
+    }
+#endif
+}
+
+void initSensorEvents() {
+    subscribeEvents(EVENT_BIT(EVENT_SENSORS), broadcastSensorEvent);
 }
@@ -3,9 +3,7 @@
 #define SENSORS_H
 
 #include "config.h"
-#include <DHT.h>
-#include <DHT_U.h>
-#include <Adafruit_Sensor.h>
+#include "json_writer.h"
 
 // DHT sensor types
 enum DHTType {
@@ -21,12 +19,36 @@ struct SensorData {
     float moisture;
     float light;
     float analog;
+    float lastPublished[2]; // Values as last sent to clients
+    unsigned long lastPublishTime;
+    bool published;
+};
+
+// Batched mode sends all readings of one cycle as a single "sensors" frame
+#define SENSOR_BATCH_BROADCAST 1
+
+// WebSocket traffic caused by sensor broadcasts
+struct SensorStats {
+    uint32_t framesSent;
+    uint32_t bytesSent;
+    uint32_t valuesSuppressed; // Readings held back by the deadband
+    uint32_t reads;
+    uint32_t readFailures; // DHT transactions that timed out or failed the checksum
+    uint32_t readMicros;
+    uint32_t maxReadMicros;
 };
 
 extern SensorData sensorData[MAX_SENSORS];
+extern SensorStats sensorStats;
+extern uint32_t sensorSampleVersion; // Bumped after every sampling cycle
 
 void initializeSensors();
+void initSensorEvents();
 void readSensors();
 void broadcastSensorData(int sensorIndex);
+void broadcastSensorFrame();
+uint8_t getSensorValues(int sensorIndex, float* values);
+void writeSensorValues(JsonWriter& json, SensorType type, const float* values);
+const char* sensorValueName(SensorType type, uint8_t index);
 
 #endif
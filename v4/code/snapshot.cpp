@@ -0,0 +1,82 @@
+// snapshot.cpp
+#include "snapshot.h"
+#include "device.h"
+#include "sensors.h"
+#include "ws_protocol.h"
+#include "commands.h"
+
+void writeSnapshotJson(JsonWriter& json) {
+    uint8_t relayMask = getRelayMask();
+
+    json.beginObject()
+        .add("type", "snapshot")
+        .add("format", SNAPSHOT_FORMAT_VERSION)
+        .add("boot", static_cast<unsigned long>(bootId))
+        .add("version", static_cast<unsigned long>(stateVersion))
+        .add("state", deviceState ? "ON" : "OFF");
+
+    json.beginArray("relays");
+    for (int i = 0; i < config.relayCount; i++) {
+        json.add((relayMask & (1 << i)) != 0);
+    }
+    json.endArray();
+
+    json.beginArray("sensors");
+    for (int i = 0; i < config.sensorCount; i++) {
+        float values[2];
+        if (getSensorValues(i, values) == 0) {
+            continue;
+        }
+        json.beginObject().add("index", i).add("type", static_cast<int>(config.sensors[i].type));
+        writeSensorValues(json, config.sensors[i].type, values);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.endObject();
+}
+
+size_t encodeSnapshotFrame(uint8_t* frame, uint16_t seq) {
+    frame[0] = WS_OP_SNAPSHOT;
+    frame[1] = seq & 0xFF;
+    frame[2] = seq >> 8;
+    for (int i = 0; i < 4; i++) {
+        frame[3 + i] = (bootId >> (8 * i)) & 0xFF;
+        frame[7 + i] = (stateVersion >> (8 * i)) & 0xFF;
+    }
+    frame[11] = deviceState ? 1 : 0;
+    frame[12] = config.relayCount;
+    frame[13] = getRelayMask();
+
+    size_t pos = 15;
+    uint8_t entries = 0;
+    for (int i = 0; i < config.sensorCount; i++) {
+        float values[2];
+        uint8_t valueCount = getSensorValues(i, values);
+        if (valueCount == 0) {
+            continue;
+        }
+        pos = wsAppendSensor(frame, pos, i, config.sensors[i].type, values, valueCount);
+        entries++;
+    }
+    frame[14] = entries;
+    return pos;
+}
+
+// Returns the number of bytes sent
+size_t sendSnapshot(uint8_t num) {
+    if (wsClientBinary[num]) {
+        uint8_t frame[WS_SNAPSHOT_FRAME_MAX_SIZE];
+        size_t frameLength = encodeSnapshotFrame(frame, wsNextSeq());
+        webSocket.sendBIN(num, frame, frameLength);
+        return frameLength;
+    }
+
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    writeSnapshotJson(json);
+    if (json.overflowed()) {
+        return 0;
+    }
+    webSocket.sendTXT(num, json.c_str(), json.length());
+    return json.length();
+}
@@ -0,0 +1,16 @@
+// snapshot.h
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "config.h"
+#include "json_writer.h"
+
+// Full device state in one message: relays, latest sensor values, device
+// status and stateVersion. Sent once to every new WebSocket client.
+#define SNAPSHOT_FORMAT_VERSION 1
+
+void writeSnapshotJson(JsonWriter& json);
+size_t encodeSnapshotFrame(uint8_t* frame, uint16_t seq);
+size_t sendSnapshot(uint8_t num);
+
+#endif
@@ -0,0 +1,146 @@
+// sse.cpp
+#include "sse.h"
+#include "snapshot.h"
+#include "json_writer.h"
+
+struct SseStream {
+    WiFiClient client;
+    WsTopics topics;
+    bool active;
+    bool sensorsPending;
+};
+
+static SseStream sseStreams[SSE_MAX_STREAMS];
+static unsigned long lastKeepalive = 0;
+SseStats sseStats = {0, 0, 0};
+
+static void closeStream(SseStream& stream) {
+    stream.client.stop();
+    stream.active = false;
+}
+
+// Writes one event without blocking; returns false if the socket could
+// not take all of it
+static bool writeEvent(SseStream& stream, const char* json, size_t jsonLength) {
+    if ((size_t)stream.client.availableForWrite() < jsonLength + 8) {
+        return false;
+    }
+    // Separate writes coalesce in the socket buffer (Nagle stays enabled)
+    stream.client.write("data: ");
+    stream.client.write(reinterpret_cast<const uint8_t*>(json), jsonLength);
+    stream.client.write("\n\n");
+    sseStats.eventsSent++;
+    return true;
+}
+
+static bool writeSnapshot(SseStream& stream) {
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    writeSnapshotJson(json);
+    return !json.overflowed() && writeEvent(stream, json.c_str(), json.length());
+}
+
+static WsTopics topicArg(const char* name, WsTopics all) {
+    return server.hasArg(name) ? static_cast<WsTopics>(server.arg(name).toInt()) : all;
+}
+
+static void handleEvents() {
+    SseStream* stream = nullptr;
+    for (uint8_t i = 0; i < SSE_MAX_STREAMS; i++) {
+        if (!sseStreams[i].active) {
+            stream = &sseStreams[i];
+            break;
+        }
+    }
+
+    if (stream == nullptr) {
+        sseStats.streamsRejected++;
+        server.sendHeader("Retry-After", "10");
+        server.send(503, "text/plain", "Too many event streams");
+        return;
+    }
+
+    uint8_t relayMask = topicArg("relays", 0xFF);
+    uint8_t sensorMask = topicArg("sensors", 0xFF);
+    bool status = !server.hasArg("status") || server.arg("status") != "0";
+
+    // The connection outlives the request; the web server drops its own
+    // reference once the handler returns
+    stream->client = server.client();
+    stream->topics = WS_TOPIC_RELAYS(relayMask) | WS_TOPIC_SENSORS(sensorMask) | (status ? WS_TOPIC_STATUS : 0);
+    stream->active = true;
+    stream->sensorsPending = false;
+
+    stream->client.write("HTTP/1.1 200 OK\r\n"
+                         "Content-Type: text/event-stream\r\n"
+                         "Cache-Control: no-cache\r\n"
+                         "Connection: keep-alive\r\n"
+                         "Access-Control-Allow-Origin: *\r\n\r\n"
+                         "retry: 5000\n\n");
+
+    if (!writeSnapshot(*stream)) {
+        stream->sensorsPending = true;
+    }
+}
+
+void initSse() {
+    server.on("/events", HTTP_GET, handleEvents);
+}
+
+uint8_t sseStreamCount() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SSE_MAX_STREAMS; i++) {
+        if (sseStreams[i].active) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void sseBroadcast(WsTopics topics, const char* json, size_t jsonLength, bool droppable) {
+    for (uint8_t i = 0; i < SSE_MAX_STREAMS; i++) {
+        SseStream& stream = sseStreams[i];
+        if (!stream.active || !(stream.topics & topics)) {
+            continue;
+        }
+        if (!stream.client.connected()) {
+            closeStream(stream);
+            continue;
+        }
+        if (writeEvent(stream, json, jsonLength)) {
+            continue;
+        }
+
+        sseStats.eventsDropped++;
+        if (droppable) {
+            stream.sensorsPending = true;
+        } else {
+            Serial.println("Closing stalled event stream");
+            closeStream(stream);
+        }
+    }
+}
+
+void sseServiceStreams() {
+    bool keepalive = millis() - lastKeepalive >= SSE_KEEPALIVE_MS;
+    if (keepalive) {
+        lastKeepalive = millis();
+    }
+
+    for (uint8_t i = 0; i < SSE_MAX_STREAMS; i++) {
+        SseStream& stream = sseStreams[i];
+        if (!stream.active) {
+            continue;
+        }
+        if (!stream.client.connected()) {
+            closeStream(stream);
+            continue;
+        }
+        if (stream.sensorsPending && writeSnapshot(stream)) {
+            stream.sensorsPending = false;
+        }
+        if (keepalive && stream.client.availableForWrite() >= 4) {
+            // Comment line keeps proxies from timing the stream out
+            stream.client.write(": \n\n");
+        }
+    }
+}
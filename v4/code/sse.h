@@ -0,0 +1,32 @@
+// sse.h
+#ifndef SSE_H
+#define SSE_H
+
+#include "config.h"
+#include "ws_protocol.h"
+
+// Server-Sent Events at /events
+// Every wsBroadcast() message is also written to the open streams as a
+// "data:" event, straight from the JSON the broadcast already serialized.
+// Streams start with a snapshot and take the same ?relays=&sensors=&status=
+// topic filter as the WebSocket subscribe command. Sensor events are
+// skipped while a stream's socket buffer is full and replaced by a
+// snapshot once it drains; a stream that cannot take a relay or status
+// event is closed.
+#define SSE_MAX_STREAMS 2
+#define SSE_KEEPALIVE_MS 15000
+
+struct SseStats {
+    uint32_t eventsSent;
+    uint32_t eventsDropped;
+    uint32_t streamsRejected;
+};
+
+extern SseStats sseStats;
+
+void initSse();
+uint8_t sseStreamCount();
+void sseBroadcast(WsTopics topics, const char* json, size_t jsonLength, bool droppable);
+void sseServiceStreams();
+
+#endif
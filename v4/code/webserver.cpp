@@ -1,10 +1,48 @@
 #include "webserver.h"
 #include "UI.h"
+#include "UI_gz.h"
 #include "led.h"
+#include "persistence.h"
+#include "ws_protocol.h"
+#include "device.h"
+#include "snapshot.h"
+#include "commands.h"
+#include "api.h"
+#include "metrics.h"
+#include "sse.h"
+#include "scheduler.h"
+#include "json_writer.h"
 #include <ArduinoJson.h>
 
+void collectPageHeaders() {
+    static const char* headers[] = {"If-None-Match", "Accept-Encoding"};
+    server.collectHeaders(headers, 2);
+}
+
+// Serve a page pre-gzipped by tools/build_ui.py; repeat loads revalidate
+// with the ETag and get an empty 304
+static void sendPage(const char* page, const uint8_t* gzipped, size_t gzippedLength, const char* etag) {
+    // Caches must not hand the gzipped body to a client that didn't ask for it
+    server.sendHeader("Vary", "Accept-Encoding");
+    if (server.header("Accept-Encoding").indexOf("gzip") < 0) {
+        server.send_P(200, "text/html", page);
+        return;
+    }
+
+    server.sendHeader("ETag", etag);
+    server.sendHeader("Cache-Control", "no-cache");
+
+    if (server.header("If-None-Match") == etag) {
+        server.send(304);
+        return;
+    }
+
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, "text/html", reinterpret_cast<const char*>(gzipped), gzippedLength);
+}
+
 void handleSetup() {
-    server.send_P(200, "text/html", SETUP_UI);
+    sendPage(SETUP_UI, SETUP_UI_GZ, sizeof(SETUP_UI_GZ), SETUP_UI_GZ_ETAG);
 }
 
 void handleNotFound() {
@@ -12,10 +50,25 @@ void handleNotFound() {
     server.send(302, "text/plain", "");
 }
 
+static void restartDevice() {
+    flushPersistence();
+    ESP.restart();
+}
+
+// Restarts from loop() so a pending response goes out first
+void scheduleRestart() {
+    if (scheduleOnce("restart", RESTART_DELAY, restartDevice) < 0) {
+        // Task table full: the caller has already sent its response, so
+        // push it out and restart now rather than not at all
+        Serial.println(F("No task slot for restart, restarting now"));
+        server.client().flush();
+        restartDevice();
+    }
+}
+
 void handleSetupMode() {
     server.send(200, "text/plain", "Entering setup mode...");
-    delay(1000);
-    ESP.restart();
+    scheduleRestart();
 }
 
 void handleSaveConfig() {
@@ -49,31 +102,51 @@ void handleSaveConfig() {
             if (config.sensors[config.sensorCount].type == SENSOR_DHT) {
                 config.sensors[config.sensorCount].dhtType = server.arg("sensor" + String(i) + "_dhtType").toInt();
             }
+            
+            // Publishing deadband and heartbeat, defaults when left empty
+            String deadband = server.arg("sensor" + String(i) + "_deadband");
+            String maxSilence = server.arg("sensor" + String(i) + "_maxSilence");
+            config.sensors[config.sensorCount].deadband = deadband.length() > 0 ? constrain(deadband.toInt(), 0, 255) : SENSOR_DEFAULT_DEADBAND;
+            config.sensors[config.sensorCount].deadbandPercent = (server.arg("sensor" + String(i) + "_deadbandMode") == "1");
+            config.sensors[config.sensorCount].maxSilence = maxSilence.length() > 0 ? constrain(maxSilence.toInt(), 1, 255) : SENSOR_DEFAULT_MAX_SILENCE;
+            
+            // Analog filter stages, defaults when the form has none
+            String oversample = server.arg("sensor" + String(i) + "_oversample");
+            String median = server.arg("sensor" + String(i) + "_median");
+            String smoothing = server.arg("sensor" + String(i) + "_smoothing");
+            config.sensors[config.sensorCount].filter = oversample.length() > 0 || median.length() > 0 || smoothing.length() > 0
+                ? SENSOR_FILTER(constrain(oversample.toInt(), 0, 3), constrain(median.toInt(), 0, 2), constrain(smoothing.toInt(), 0, 7))
+                : SENSOR_DEFAULT_FILTER;
             config.sensorCount++;
         }
     }
 
-    // Save configuration to EEPROM
+    // Written to EEPROM by restartDevice()
     saveConfig();
     startLedPattern(LED_PATTERN_RESET);
 
     // Notify user and reboot
     server.send(200, "text/plain", "Configuration saved! Rebooting...");
-    delay(1000);
-    ESP.restart();
+    scheduleRestart();
 }
 
 void initWebServer() {
     // Set up web server routes
     server.on("/", []() {
-        server.send_P(200, "text/html", WEB_UI);
+        sendPage(WEB_UI, WEB_UI_GZ, sizeof(WEB_UI_GZ), WEB_UI_GZ_ETAG);
     });
+    collectPageHeaders();
+    initApi();
+    initMetrics();
+    initSse();
     
     server.onNotFound(handleNotFound);
     
     // Start WebSocket server
     webSocket.begin();
     webSocket.onEvent(webSocketEvent);
+    initWsProtocol();
+    initCommands();
     
     // Start web server
     server.begin();
@@ -82,26 +155,90 @@ void initWebServer() {
     Serial.println("Web server started");
 }
 
+// An ack the client's send buffer can't take is dropped rather than
+// blocking; a retry of the command is answered from the dedup ring
+static void sendAck(uint8_t num, uint32_t id, const CommandResult& result, uint16_t seq) {
+    if (wsClientBinary[num]) {
+        uint8_t frame[WS_FRAME_MAX_SIZE];
+        size_t frameLength = wsEncodeAck(frame, seq, result.ok, result.version);
+        if (wsCanSend(num, frameLength)) {
+            webSocket.sendBIN(num, frame, frameLength);
+        } else {
+            wsStats.framesDropped++;
+        }
+        return;
+    }
+
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject()
+        .add("type", result.ok ? "ack" : "nack")
+        .add("id", static_cast<unsigned long>(id))
+        .add("version", static_cast<unsigned long>(result.version))
+        .endObject();
+    if (wsCanSend(num, json.length())) {
+        webSocket.sendTXT(num, json.c_str(), json.length());
+    } else {
+        wsStats.framesDropped++;
+    }
+}
+
+// Commands with an id are applied at most once and always answered
+static void handleRelayCommand(uint8_t num, uint32_t session, bool hasId, uint32_t id, uint8_t mask, uint8_t states, uint16_t seq) {
+    CommandResult result = executeRelayCommand(session, hasId, id, mask, states, seq);
+    if (hasId) {
+        sendAck(num, id, result, seq);
+    }
+}
+
+// Reconnecting clients pass ?boot=B&version=V from the last state they saw
+static bool sendResumeDelta(uint8_t num, const char* url) {
+    const char* bootArg = strstr(url, "boot=");
+    const char* versionArg = strstr(url, "version=");
+    uint8_t changedMask;
+
+    if (!bootArg || !versionArg || strtoul(bootArg + 5, nullptr, 10) != bootId ||
+        !relayChangesSince(strtoul(versionArg + 8, nullptr, 10), changedMask)) {
+        return false;
+    }
+
+    uint8_t relayMask = getRelayMask();
+    if (wsClientBinary[num]) {
+        uint8_t frame[WS_FRAME_MAX_SIZE];
+        size_t frameLength = wsEncodeDelta(frame, wsNextSeq(), stateVersion, changedMask, relayMask);
+        webSocket.sendBIN(num, frame, frameLength);
+        return true;
+    }
+
+    JsonWriter json(messageBuffer, sizeof(messageBuffer));
+    json.beginObject().add("type", "delta").add("version", static_cast<unsigned long>(stateVersion));
+    json.beginArray("relays");
+    for (int i = 0; i < config.relayCount; i++) {
+        if (changedMask & (1 << i)) {
+            json.beginObject().add("index", i).add("state", (relayMask & (1 << i)) != 0).endObject();
+        }
+    }
+    json.endArray().endObject();
+    webSocket.sendTXT(num, json.c_str(), json.length());
+    return true;
+}
+
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length) {
     switch(type) {
         case WStype_DISCONNECTED:
             Serial.printf("[%u] Disconnected!\n", num);
+            forgetCommands(wsClientSession[num]);
+            wsClientDisconnected(num);
             break;
             
         case WStype_CONNECTED:
             {
                 Serial.printf("[%u] Connected from url: %s\n", num, payload);
+                wsClientConnected(num);
                 
-                // Send current relay states
-                for (int i = 0; i < config.relayCount; i++) {
-                    StaticJsonDocument<200> doc;
-                    doc["type"] = "relay";
-                    doc["index"] = i;
-                    doc["state"] = digitalRead(config.relayPins[i]) == LOW;
-                    
-                    String jsonString;
-                    serializeJson(doc, jsonString);
-                    webSocket.sendTXT(num, jsonString);
+                // One message with everything a dashboard needs to render,
+                // or just the relay changes a resuming client missed
+                if (!sendResumeDelta(num, reinterpret_cast<const char*>(payload))) {
+                    sendSnapshot(num);
                 }
             }
             break;
@@ -118,24 +255,50 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length
                 }
                 
                 const char* msgType = doc["type"];
+                if (msgType == nullptr) {
+                    return;
+                }
+                
+                // An optional "id" makes relay commands idempotent and acknowledged
+                bool hasId = doc.containsKey("id");
+                uint32_t id = doc["id"];
                 
                 if (strcmp(msgType, "relay") == 0) {
                     int index = doc["index"];
                     bool state = doc["state"];
-                    
-                    if (index >= 0 && index < config.relayCount) {
-                        digitalWrite(config.relayPins[index], !state); // Invert state because relays are active LOW
-                        
-                        // Broadcast the new state to all clients
-                        StaticJsonDocument<200> response;
-                        response["type"] = "relay";
-                        response["index"] = index;
-                        response["state"] = state;
-                        
-                        String jsonString;
-                        serializeJson(response, jsonString);
-                        webSocket.broadcastTXT(jsonString);
-                    }
+                    uint8_t mask = (index >= 0 && index < config.relayCount) ? (1 << index) : 0;
+                    handleRelayCommand(num, COMMAND_SESSION_SHARED, hasId, id, mask, state ? mask : 0, wsNextSeq());
+                } else if (strcmp(msgType, "relays") == 0) {
+                    // {"type":"relays","mask":m,"states":s} switches all relays in m at once
+                    handleRelayCommand(num, COMMAND_SESSION_SHARED, hasId, id, doc["mask"], doc["states"], wsNextSeq());
+                } else if (strcmp(msgType, "subscribe") == 0) {
+                    // {"type":"subscribe","relays":m,"sensors":m,"status":b,"debug":b}, bitmasks
+                    wsSubscribe(num, doc["relays"], doc["sensors"], doc["status"], doc["debug"]);
+                }
+            }
+            break;
+            
+        case WStype_BIN:
+            {
+                // Binary clients skip JSON parsing entirely
+                WsFrameHeader header;
+                if (!wsDecodeHeader(payload, length, header)) {
+                    return;
+                }
+                
+                if (length < WS_FRAME_HEADER_SIZE + 2) {
+                    return;
+                }
+                
+                // Binary commands use the frame sequence number as their id,
+                // deduplicated within this connection only
+                if (header.opcode == WS_OP_RELAY_SET) {
+                    uint8_t mask = payload[3] < config.relayCount ? (1 << payload[3]) : 0;
+                    handleRelayCommand(num, wsClientSession[num], true, header.seq, mask, payload[4] ? mask : 0, header.seq);
+                } else if (header.opcode == WS_OP_RELAY_MASK) {
+                    handleRelayCommand(num, wsClientSession[num], true, header.seq, payload[3], payload[4], header.seq);
+                } else if (header.opcode == WS_OP_SUBSCRIBE && length >= WS_FRAME_HEADER_SIZE + 3) {
+                    wsSubscribe(num, payload[3], payload[4], payload[5] & 0x01, payload[5] & 0x02);
                 }
             }
             break;
@@ -5,11 +5,13 @@
 #include "config.h"
 
 void initWebServer();
+void collectPageHeaders();
 void handleSetup();
 void handleSetupMode();
 void handleNotFound();
 void handleSaveConfig();
+void scheduleRestart();
 
-extern WebSocketsServer webSocket;
+extern WsServer webSocket;
 
 #endif
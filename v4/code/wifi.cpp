@@ -2,12 +2,28 @@
 #include "wifi.h"
 #include "webserver.h"
 #include "led.h"
+#include "events.h"
 
 extern bool isSetupMode;
 
-void startCaptivePortal()
+uint32_t wifiReconnects = 0;
+
+static WiFiState wifiState = WIFI_STATE_IDLE;
+static WiFiCallback firstConnectCallback = nullptr;
+static WiFiEventHandler gotIPHandler;
+static WiFiEventHandler disconnectedHandler;
+static volatile bool gotIPEvent = false;
+static volatile bool disconnectedEvent = false;
+static bool everConnected = false;
+static bool portalActive = false;
+static unsigned long wifiStartTime = 0;
+static unsigned long stateSince = 0;
+static unsigned long backoffDelay = 0;
+static uint8_t failedAttempts = 0;
+
+void startCaptivePortal(bool keepStation)
 {
-    WiFi.mode(WIFI_AP);
+    WiFi.mode(keepStation ? WIFI_AP_STA : WIFI_AP);
     WiFi.softAP(AP_SSID, AP_PASSWORD);
 
     dnsServer.start(DNS_PORT, "*", WiFi.softAPIP());
@@ -16,6 +32,7 @@ void startCaptivePortal()
     server.on("/save-config", HTTP_POST, handleSaveConfig);
     server.on("/enter-setup", handleSetupMode);
     server.onNotFound(handleNotFound);
+    collectPageHeaders();
     
     server.begin();
     
@@ -23,54 +40,139 @@ void startCaptivePortal()
     startLedPattern(LED_PATTERN_SETUP);
 }
 
-bool attemptWiFiConnection()
+static void setWiFiState(WiFiState state)
+{
+    wifiState = state;
+    stateSince = millis();
+}
+
+static void beginAttempt()
+{
+    gotIPEvent = false;
+    disconnectedEvent = false;
+    if (!portalActive) {
+        startLedPattern(LED_PATTERN_WIFI_CONNECTING);
+    }
+    WiFi.begin(config.wifiSSID, config.wifiPassword);
+    setWiFiState(WIFI_STATE_CONNECTING);
+}
+
+// Station scans and channel changes move the softAP channel and drop
+// whoever is filling in the setup form
+static bool portalInUse()
+{
+    return portalActive && WiFi.softAPgetStationNum() > 0;
+}
+
+// Exponential backoff with equal jitter: half the delay fixed, half random
+static void startBackoff()
+{
+    WiFi.disconnect();
+    if (failedAttempts < 16) {
+        failedAttempts++;
+    }
+    unsigned long ceiling = min<unsigned long>(WIFI_BACKOFF_MAX, (unsigned long)WIFI_BACKOFF_MIN << (failedAttempts - 1));
+    backoffDelay = ceiling / 2 + random(ceiling / 2 + 1);
+    setWiFiState(WIFI_STATE_BACKOFF);
+}
+
+bool startWiFi(WiFiCallback onFirstConnect)
 {
     if (strlen(config.wifiSSID) == 0) {
         startLedPattern(LED_PATTERN_ERROR);
         return false;
     }
 
-    startLedPattern(LED_PATTERN_WIFI_CONNECTING);
-    
+    firstConnectCallback = onFirstConnect;
+
+    // Event handlers only set flags; updateWiFi() does the work from loop()
+    gotIPHandler = WiFi.onStationModeGotIP([](const WiFiEventStationModeGotIP&) {
+        gotIPEvent = true;
+    });
+    disconnectedHandler = WiFi.onStationModeDisconnected([](const WiFiEventStationModeDisconnected&) {
+        disconnectedEvent = true;
+    });
+
+    // Reconnects are driven by the state machine, not the SDK
+    WiFi.setAutoReconnect(false);
     WiFi.mode(WIFI_STA);
-    WiFi.begin(config.wifiSSID, config.wifiPassword);
-    
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < MAX_WIFI_CONNECT_ATTEMPTS) {
-        delay(WIFI_CONNECT_TIMEOUT / MAX_WIFI_CONNECT_ATTEMPTS);
-        attempts++;
-        
-        if (attempts == MAX_WIFI_CONNECT_ATTEMPTS) {
-            startLedPattern(LED_PATTERN_ERROR);
-            return false;
-        }
-    }
-    
-    startLedPattern(LED_PATTERN_SUCCESS);
+    wifiStartTime = millis();
+    beginAttempt();
     return true;
 }
 
-void checkWiFiConnection()
+void updateWiFi()
 {
-    if (isSetupMode)
-        return;
-        
-    static unsigned long lastWiFiCheck = 0;
-    unsigned long currentMillis = millis();
-    
-    if (currentMillis - lastWiFiCheck >= WIFI_RETRY_INTERVAL) {
-        lastWiFiCheck = currentMillis;
-        
-        if (WiFi.status() != WL_CONNECTED) {
-            startLedPattern(LED_PATTERN_ERROR);
-            
+    unsigned long now = millis();
+
+    switch (wifiState) {
+    case WIFI_STATE_IDLE:
+    case WIFI_STATE_PORTAL: // Only reported by getWiFiState()
+        break;
+
+    case WIFI_STATE_CONNECTING:
+        if (gotIPEvent || WiFi.status() == WL_CONNECTED) {
+            if (everConnected) {
+                wifiReconnects++;
+            }
+            failedAttempts = 0;
+            setWiFiState(WIFI_STATE_CONNECTED);
+            Serial.println("WiFi connected: " + WiFi.localIP().toString());
+
+            if (portalActive) {
+                // The portal owns the web server; come back up in normal mode
+                scheduleRestart();
+                break;
+            }
+            publishEvent(EVENT_WIFI_CONNECTED);
+            if (!everConnected) {
+                everConnected = true;
+                if (firstConnectCallback) {
+                    firstConnectCallback();
+                }
+            }
+        } else if (portalInUse()) {
+            // Retried once the portal clients have left
             WiFi.disconnect();
-            delay(1000);
-            
-            startLedPattern(LED_PATTERN_WIFI_CONNECTING);
-            WiFi.begin(config.wifiSSID, config.wifiPassword);
+            setWiFiState(WIFI_STATE_BACKOFF);
+        } else if (disconnectedEvent || WiFi.status() == WL_CONNECT_FAILED ||
+                   WiFi.status() == WL_NO_SSID_AVAIL) {
+            // Wrong password or no such network; waiting out the attempt
+            // timeout would not change the answer
+            startBackoff();
+        } else if (now - stateSince >= WIFI_ATTEMPT_TIMEOUT) {
+            startBackoff();
         }
+        break;
+
+    case WIFI_STATE_CONNECTED:
+        if (disconnectedEvent || WiFi.status() != WL_CONNECTED) {
+            Serial.println("WiFi connection lost");
+            publishEvent(EVENT_WIFI_LOST);
+            startBackoff();
+        }
+        break;
+
+    case WIFI_STATE_BACKOFF:
+        if (now - stateSince >= backoffDelay && !portalInUse()) {
+            beginAttempt();
+        }
+        break;
+    }
+
+    if (!everConnected && !portalActive && now - wifiStartTime >= WIFI_CONNECT_TIMEOUT) {
+        Serial.println("WiFi unavailable, starting setup portal");
+        portalActive = true;
+        startCaptivePortal(true);
+    }
+}
+
+WiFiState getWiFiState()
+{
+    if (portalActive && wifiState != WIFI_STATE_CONNECTED) {
+        return WIFI_STATE_PORTAL;
     }
+    return wifiState;
 }
 
 void setupMDNS()
@@ -82,3 +184,8 @@ void setupMDNS()
         startLedPattern(LED_PATTERN_ERROR);
     }
 }
+
+void updateMDNS()
+{
+    MDNS.update();
+}
@@ -4,9 +4,35 @@
 
 #include "config.h"
 
-void startCaptivePortal();
-bool attemptWiFiConnection();
-void checkWiFiConnection();
+// Non-blocking station connection
+// updateWiFi() runs from the scheduler and reacts to the station events.
+// Failed attempts back off exponentially from WIFI_BACKOFF_MIN up to
+// WIFI_BACKOFF_MAX with random jitter. If the first connection after boot
+// has not come up within WIFI_CONNECT_TIMEOUT the captive portal starts
+// next to the station, which keeps retrying while no one is connected to
+// the portal; once it connects the device restarts into normal mode.
+#define WIFI_STATE_INTERVAL 100
+#define WIFI_ATTEMPT_TIMEOUT 10000
+#define WIFI_BACKOFF_MIN 1000
+#define WIFI_BACKOFF_MAX 60000
+
+enum WiFiState {
+    WIFI_STATE_IDLE = 0,
+    WIFI_STATE_CONNECTING = 1,
+    WIFI_STATE_CONNECTED = 2,
+    WIFI_STATE_BACKOFF = 3,
+    WIFI_STATE_PORTAL = 4 // Portal up, station retrying in the background
+};
+
+typedef void (*WiFiCallback)();
+
+void startCaptivePortal(bool keepStation = false);
+bool startWiFi(WiFiCallback onFirstConnect);
+void updateWiFi();
+WiFiState getWiFiState();
 void setupMDNS();
+void updateMDNS();
+
+extern uint32_t wifiReconnects; // Successful reconnects after a lost connection
 
 #endif
@@ -0,0 +1,226 @@
+// ws_protocol.cpp
+#include "ws_protocol.h"
+#include "snapshot.h"
+#include "sse.h"
+
+static_assert(MAX_RELAYS + MAX_SENSORS + 1 <= 16, "WsTopics has one bit per relay, sensor and status");
+
+bool wsClientBinary[WEBSOCKETS_SERVER_CLIENT_MAX] = {false};
+uint32_t wsClientSession[WEBSOCKETS_SERVER_CLIENT_MAX];
+WsTopics wsClientTopics[WEBSOCKETS_SERVER_CLIENT_MAX];
+WsClientFlow wsClientFlow[WEBSOCKETS_SERVER_CLIENT_MAX];
+WsStats wsStats = {0, 0, 0, 0};
+
+static uint16_t txSeq = 0;
+static uint32_t lastSession = 0;
+
+static void putHeader(uint8_t* frame, uint8_t opcode, uint16_t seq) {
+    frame[0] = opcode;
+    frame[1] = seq & 0xFF;
+    frame[2] = seq >> 8;
+}
+
+// True if a comma-separated Sec-WebSocket-Protocol list names the binary protocol
+static bool offersBinaryProtocol(const String& protocols) {
+    const size_t nameLength = strlen(WS_BINARY_PROTOCOL);
+    const char* token = protocols.c_str();
+
+    while (*token) {
+        while (*token == ' ' || *token == ',') {
+            token++;
+        }
+        const char* end = token;
+        while (*end && *end != ',' && *end != ' ') {
+            end++;
+        }
+        if (static_cast<size_t>(end - token) == nameLength && strncmp(token, WS_BINARY_PROTOCOL, nameLength) == 0) {
+            return true;
+        }
+        token = end;
+    }
+    return false;
+}
+
+void initWsProtocol() {
+    // The library answers any offered subprotocol list with the one it was
+    // created with, so a list without ours is refused rather than answered
+    // with a protocol the client never asked for
+    static const char* headers[] = {"Sec-WebSocket-Protocol"};
+    webSocket.onValidateHttpHeader([](String headerName, String headerValue) {
+        return !headerName.equalsIgnoreCase("Sec-WebSocket-Protocol") || offersBinaryProtocol(headerValue);
+    }, headers, 0);
+}
+
+void wsClientConnected(uint8_t num) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) {
+        wsClientBinary[num] = offersBinaryProtocol(webSocket.clientProtocol(num));
+        // Skips the shared session 0 and the all-ones marker on wrap
+        do {
+            lastSession++;
+        } while (lastSession == 0 || lastSession == 0xFFFFFFFF);
+        wsClientSession[num] = lastSession;
+        wsClientTopics[num] = WS_TOPIC_DEFAULT; // Until the client subscribes
+        wsClientFlow[num].snapshotPending = false;
+    }
+}
+
+void wsClientDisconnected(uint8_t num) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) {
+        wsClientBinary[num] = false;
+        wsClientSession[num] = 0;
+    }
+}
+
+uint16_t wsNextSeq() {
+    return ++txSeq;
+}
+
+void wsSubscribe(uint8_t num, uint8_t relayMask, uint8_t sensorMask, bool status, bool debug) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX) {
+        return;
+    }
+    wsClientTopics[num] = WS_TOPIC_RELAYS(relayMask) | WS_TOPIC_SENSORS(sensorMask) |
+                          (status ? WS_TOPIC_STATUS : 0) | (debug ? WS_TOPIC_DEBUG : 0);
+}
+
+bool wsHasSubscribers(WsTopics topics) {
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        if ((wsClientTopics[num] & topics) && webSocket.clientIsConnected(num)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// True if the client's send buffer takes the whole frame without blocking
+bool wsCanSend(uint8_t num, size_t length) {
+    return webSocket.clientWritable(num) >= length + WS_FRAME_OVERHEAD;
+}
+
+bool wsDecodeHeader(const uint8_t* frame, size_t length, WsFrameHeader& header) {
+    if (length < WS_FRAME_HEADER_SIZE) {
+        return false;
+    }
+    header.opcode = frame[0];
+    header.seq = frame[1] | (frame[2] << 8);
+    return true;
+}
+
+size_t wsEncodeRelayState(uint8_t* frame, uint16_t seq, uint8_t relayCount, uint8_t relayMask) {
+    putHeader(frame, WS_OP_RELAY_STATE, seq);
+    frame[3] = relayCount;
+    frame[4] = relayMask;
+    return 5;
+}
+
+static size_t putU32(uint8_t* frame, size_t pos, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        frame[pos++] = (value >> (8 * i)) & 0xFF;
+    }
+    return pos;
+}
+
+size_t wsEncodeAck(uint8_t* frame, uint16_t seq, bool ok, uint32_t version) {
+    putHeader(frame, WS_OP_ACK, seq);
+    frame[3] = ok ? 1 : 0;
+    return putU32(frame, 4, version);
+}
+
+size_t wsEncodeDelta(uint8_t* frame, uint16_t seq, uint32_t version, uint8_t changedMask, uint8_t relayMask) {
+    putHeader(frame, WS_OP_DELTA, seq);
+    size_t pos = putU32(frame, WS_FRAME_HEADER_SIZE, version);
+    frame[pos++] = changedMask;
+    frame[pos++] = relayMask;
+    return pos;
+}
+
+size_t wsEncodeStatus(uint8_t* frame, uint16_t seq, bool isOn) {
+    putHeader(frame, WS_OP_STATUS, seq);
+    frame[3] = isOn ? 1 : 0;
+    return 4;
+}
+
+size_t wsAppendSensor(uint8_t* frame, size_t pos, uint8_t index, uint8_t type, const float* values, uint8_t count) {
+    count = min<uint8_t>(count, (WS_SENSOR_ENTRY_MAX_SIZE - 3) / 2);
+    frame[pos++] = index;
+    frame[pos++] = type;
+    frame[pos++] = count;
+
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t tenths = isnan(values[i]) ? INT16_MIN : static_cast<int16_t>(lroundf(values[i] * 10));
+        frame[pos++] = tenths & 0xFF;
+        frame[pos++] = static_cast<uint16_t>(tenths) >> 8;
+    }
+    return pos;
+}
+
+size_t wsEncodeSensor(uint8_t* frame, uint16_t seq, uint8_t index, uint8_t type, const float* values, uint8_t count) {
+    putHeader(frame, WS_OP_SENSOR, seq);
+    return wsAppendSensor(frame, WS_FRAME_HEADER_SIZE, index, type, values, count);
+}
+
+size_t wsEncodeSensorsHeader(uint8_t* frame, uint16_t seq, uint8_t sensorCount) {
+    putHeader(frame, WS_OP_SENSORS, seq);
+    frame[3] = sensorCount;
+    return 4;
+}
+
+static void markSnapshotPending(WsClientFlow& flow) {
+    if (!flow.snapshotPending) {
+        flow.snapshotPending = true;
+        flow.pendingSince = millis();
+    }
+}
+
+void wsBroadcast(WsTopics topics, const char* json, size_t jsonLength, const uint8_t* frame, size_t frameLength, bool droppable) {
+    sseBroadcast(topics, json, jsonLength, droppable);
+
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        if (!(wsClientTopics[num] & topics) || !webSocket.clientIsConnected(num) ||
+            (wsClientBinary[num] && frameLength == 0)) {
+            continue;
+        }
+
+        WsClientFlow& flow = wsClientFlow[num];
+        size_t length = wsClientBinary[num] ? frameLength : jsonLength;
+
+        // The pending snapshot supersedes anything sent before it
+        if (flow.snapshotPending || !wsCanSend(num, length)) {
+            wsStats.framesDropped++;
+            if (topics != WS_TOPIC_DEBUG) {
+                markSnapshotPending(flow);
+            }
+            continue;
+        }
+
+        if (wsClientBinary[num]) {
+            webSocket.sendBIN(num, frame, frameLength);
+        } else {
+            webSocket.sendTXT(num, json, jsonLength);
+        }
+        wsStats.bytesSent += length;
+        wsStats.framesSent++;
+    }
+}
+
+void wsServiceClients() {
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        WsClientFlow& flow = wsClientFlow[num];
+        if (!flow.snapshotPending || !webSocket.clientIsConnected(num)) {
+            continue;
+        }
+
+        size_t snapshotMax = wsClientBinary[num] ? WS_SNAPSHOT_FRAME_MAX_SIZE : MESSAGE_BUFFER_SIZE;
+        if (wsCanSend(num, snapshotMax)) {
+            flow.snapshotPending = false;
+            size_t length = sendSnapshot(num);
+            wsStats.bytesSent += length;
+            wsStats.framesSent++;
+        } else if (millis() - flow.pendingSince >= WS_STALL_TIMEOUT) {
+            Serial.printf("[%u] Evicting stalled client\n", num);
+            flow.snapshotPending = false;
+            wsStats.clientsEvicted++;
+            webSocket.dropClient(num);
+        }
+    }
+}
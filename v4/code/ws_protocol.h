@@ -0,0 +1,101 @@
+// ws_protocol.h
+#ifndef WS_PROTOCOL_H
+#define WS_PROTOCOL_H
+
+#include "config.h"
+
+// Compact binary WebSocket protocol
+// Clients that request the WS_BINARY_PROTOCOL subprotocol during the
+// handshake exchange binary frames instead of JSON; the choice is made per
+// client from its own handshake. Handshakes offering only other
+// subprotocols are refused. Every frame starts with
+// a 3-byte header (opcode, little-endian 16-bit sequence number); sensor
+// values are signed 16-bit tenths. JSON clients are unaffected.
+#define WS_BINARY_PROTOCOL "relay.bin.v1"
+#define WS_FRAME_HEADER_SIZE 3
+#define WS_FRAME_MAX_SIZE 16
+#define WS_SENSOR_ENTRY_MAX_SIZE 7
+#define WS_SENSORS_FRAME_MAX_SIZE (WS_FRAME_HEADER_SIZE + 1 + MAX_SENSORS * WS_SENSOR_ENTRY_MAX_SIZE)
+#define WS_SNAPSHOT_FRAME_MAX_SIZE (WS_FRAME_HEADER_SIZE + 12 + MAX_SENSORS * WS_SENSOR_ENTRY_MAX_SIZE)
+
+// Per-client flow control
+// A client's outbound queue is its TCP send buffer. A message is only
+// written when the buffer has room for the whole frame, so a send never
+// blocks loop(). Messages that don't fit are not queued: the client is
+// marked for one snapshot, which carries the latest relay, status and
+// sensor values and goes out from wsServiceClients() once the buffer has
+// drained (latest value wins). Debug reports are simply dropped. A client
+// that cannot take its pending snapshot for WS_STALL_TIMEOUT is
+// disconnected.
+#define WS_FRAME_OVERHEAD 4 // Unmasked server frame header for payloads below 64 KB
+#define WS_STALL_TIMEOUT 10000
+
+struct WsClientFlow {
+    unsigned long pendingSince;
+    bool snapshotPending;
+};
+
+// Topic bitmask: one bit per relay, one per sensor, one for device status
+typedef uint16_t WsTopics;
+#define WS_TOPIC_RELAY(i) ((WsTopics)1 << (i))
+#define WS_TOPIC_RELAYS(mask) ((WsTopics)((mask) & ((1 << MAX_RELAYS) - 1)))
+#define WS_TOPIC_SENSOR(i) ((WsTopics)1 << (MAX_RELAYS + (i)))
+#define WS_TOPIC_SENSORS(mask) ((WsTopics)((mask) & ((1 << MAX_SENSORS) - 1)) << MAX_RELAYS)
+#define WS_TOPIC_STATUS ((WsTopics)1 << (MAX_RELAYS + MAX_SENSORS))
+#define WS_TOPIC_DEBUG ((WsTopics)1 << (MAX_RELAYS + MAX_SENSORS + 1)) // Opt-in, JSON only
+#define WS_TOPIC_ALL ((WsTopics)0xFFFF)
+#define WS_TOPIC_DEFAULT (WS_TOPIC_ALL & ~WS_TOPIC_DEBUG)
+
+enum WsOpcode {
+    WS_OP_RELAY_SET = 0x01,    // C->S: index, state
+    WS_OP_RELAY_MASK = 0x02,   // C->S: relay bitmask, state bitmask
+    WS_OP_SUBSCRIBE = 0x03,    // C->S: relay bitmask, sensor bitmask, flags (bit 0 status, bit 1 debug)
+    WS_OP_RELAY_STATE = 0x81,  // S->C: relay count, relay bitmask
+    WS_OP_STATUS = 0x82,       // S->C: device state
+    WS_OP_SENSOR = 0x83,       // S->C: index, type, value count, int16 values
+    WS_OP_SENSORS = 0x84,      // S->C: sensor count, then one WS_OP_SENSOR body per sensor
+    WS_OP_SNAPSHOT = 0x85,     // S->C: boot id (u32), version (u32), device state, relay count, relay bitmask, then WS_OP_SENSORS body
+    WS_OP_ACK = 0x86,          // S->C: command seq echoed in the header; ok, version (u32)
+    WS_OP_DELTA = 0x87         // S->C: version (u32), changed relay bitmask, relay bitmask
+};
+
+struct WsFrameHeader {
+    uint8_t opcode;
+    uint16_t seq;
+};
+
+// Totals over everything sent through wsBroadcast()
+struct WsStats {
+    uint32_t framesSent;
+    uint32_t bytesSent;
+    uint32_t framesDropped;
+    uint32_t clientsEvicted;
+};
+
+extern bool wsClientBinary[WEBSOCKETS_SERVER_CLIENT_MAX];
+extern uint32_t wsClientSession[WEBSOCKETS_SERVER_CLIENT_MAX]; // Unique per connection, never 0
+extern WsTopics wsClientTopics[WEBSOCKETS_SERVER_CLIENT_MAX];
+extern WsClientFlow wsClientFlow[WEBSOCKETS_SERVER_CLIENT_MAX];
+extern WsStats wsStats;
+
+void initWsProtocol();
+void wsClientConnected(uint8_t num);
+void wsClientDisconnected(uint8_t num);
+uint16_t wsNextSeq();
+void wsSubscribe(uint8_t num, uint8_t relayMask, uint8_t sensorMask, bool status, bool debug = false);
+bool wsHasSubscribers(WsTopics topics);
+bool wsCanSend(uint8_t num, size_t length);
+bool wsDecodeHeader(const uint8_t* frame, size_t length, WsFrameHeader& header);
+size_t wsEncodeRelayState(uint8_t* frame, uint16_t seq, uint8_t relayCount, uint8_t relayMask);
+size_t wsEncodeAck(uint8_t* frame, uint16_t seq, bool ok, uint32_t version);
+size_t wsEncodeDelta(uint8_t* frame, uint16_t seq, uint32_t version, uint8_t changedMask, uint8_t relayMask);
+size_t wsEncodeStatus(uint8_t* frame, uint16_t seq, bool isOn);
+size_t wsEncodeSensor(uint8_t* frame, uint16_t seq, uint8_t index, uint8_t type, const float* values, uint8_t count);
+size_t wsEncodeSensorsHeader(uint8_t* frame, uint16_t seq, uint8_t sensorCount);
+size_t wsAppendSensor(uint8_t* frame, size_t pos, uint8_t index, uint8_t type, const float* values, uint8_t count);
+// A frameLength of 0 marks a JSON-only message that binary clients skip;
+// droppable only matters to SSE streams, which close on anything else
+void wsBroadcast(WsTopics topics, const char* json, size_t jsonLength, const uint8_t* frame, size_t frameLength, bool droppable = false);
+void wsServiceClients();
+
+#endif
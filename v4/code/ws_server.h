@@ -0,0 +1,35 @@
+// ws_server.h
+#ifndef WS_SERVER_H
+#define WS_SERVER_H
+
+#include <WebSocketsServer.h>
+
+// WebSocketsServer with read access to per-client connection state
+// The library keeps the Sec-WebSocket-Protocol a client offered and its
+// TCP connection in the client slot but has no public accessor for them.
+class WsServer : public WebSocketsServer {
+public:
+    using WebSocketsServer::WebSocketsServer;
+
+    // Subprotocol list from this client's handshake, empty if it offered none
+    const String& clientProtocol(uint8_t num) {
+        return _clients[num].cProtocol;
+    }
+
+    // Free space in the client's TCP send buffer; a write up to this size
+    // returns without waiting for the peer
+    size_t clientWritable(uint8_t num) {
+        return _clients[num].tcp ? _clients[num].tcp->availableForWrite() : 0;
+    }
+
+    // Resets the client's TCP connection without a close frame, which
+    // disconnect() would write to a socket that is already full. The
+    // library notices on its next loop and reports WStype_DISCONNECTED.
+    void dropClient(uint8_t num) {
+        if (_clients[num].tcp) {
+            _clients[num].tcp->abort();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+// fixture.h
+// Shared setup for tests that drive the firmware the way loop() does
+#ifndef FIXTURE_H
+#define FIXTURE_H
+
+#include "test.h"
+#include "config.h"
+#include "device.h"
+#include "events.h"
+#include "persistence.h"
+#include "scheduler.h"
+#include "ws_protocol.h"
+#include "sse.h"
+#include "adafruit_io.h"
+#include "webserver.h"
+
+#define FIXTURE_FIRST_RELAY_PIN 12 // Relays on GPIO12 and up
+
+// Relays configured and driven OFF (active LOW) with outputs enabled
+inline void configureRelays(uint8_t count) {
+    config.relayCount = count;
+    for (uint8_t i = 0; i < count; i++) {
+        config.relayPins[i] = FIXTURE_FIRST_RELAY_PIN + i;
+        digitalWrite(config.relayPins[i], HIGH);
+        pinMode(config.relayPins[i], OUTPUT);
+    }
+}
+
+// Routes and the WebSocket handler are registered once per binary; clients
+// left connected by an earlier case are dropped
+inline void startWebServer() {
+    static bool started = false;
+    if (!started) {
+        initWebServer();
+        started = true;
+    }
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        webSocket.dropClient(num);
+    }
+    webSocket.loop();
+}
+
+// loop() with the network up, one pass every step ms for duration ms
+inline void runLoop(uint32_t duration, uint32_t step = 10) {
+    for (uint32_t elapsed = 0; elapsed < duration; elapsed += step) {
+        server.handleClient();
+        handlePersistence();
+        webSocket.loop();
+        wsServiceClients();
+        sseServiceStreams();
+        updateAdafruitIO();
+        dispatchEvents();
+        runScheduler();
+        hostAdvanceMillis(step);
+    }
+}
+
+#endif
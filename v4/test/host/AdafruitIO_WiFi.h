@@ -0,0 +1,139 @@
+// AdafruitIO_WiFi.h
+// Host Adafruit IO client backed by a stand-in MQTT broker. The broker
+// state (reachable, accepting the credentials) is set by the test, and
+// every connect and ping is counted so reconnect behavior can be checked
+// without a network.
+#ifndef HOST_ADAFRUITIO_WIFI_H
+#define HOST_ADAFRUITIO_WIFI_H
+
+#include <ESP8266WiFi.h>
+#include <string>
+#include <vector>
+
+#define HOST_IO_FEED_MAX 4
+
+struct HostBroker {
+    bool reachable = true;
+    bool acceptCredentials = true;
+    unsigned long connectMillis = 0; // Simulated time one connect attempt takes
+    uint32_t connectAttempts = 0;
+    uint32_t sessions = 0;           // Successful connects
+    uint32_t pings = 0;
+    bool sessionOpen = false;
+
+    // Drops the current session, e.g. broker restart
+    void dropSession() { sessionOpen = false; }
+};
+
+extern HostBroker hostBroker;
+
+class AdafruitIO_Data {
+public:
+    explicit AdafruitIO_Data(const char* value) : text(value) {}
+    int toInt() { return atoi(text.c_str()); }
+    bool toBool() { return toInt() != 0; }
+    char* value() { return &text[0]; }
+
+private:
+    std::string text;
+};
+
+typedef void (*AdafruitIODataCallbackType)(AdafruitIO_Data* data);
+
+class AdafruitIO_Feed {
+public:
+    bool save(int value) { return store(String(value)); }
+    bool save(float value) { return store(String(value)); }
+    bool save(const char* value) { return store(String(value)); }
+    bool save(String value) { return store(value); }
+    void onMessage(AdafruitIODataCallbackType callback) { messageCallback = callback; }
+    bool get() { return true; }
+
+    // Test side: a value arriving from the broker
+    void hostReceive(const char* value) {
+        AdafruitIO_Data data(value);
+        if (messageCallback) {
+            messageCallback(&data);
+        }
+    }
+
+    String name;
+    String lastValue;
+    uint32_t saves = 0;
+
+private:
+    bool store(const String& value) {
+        lastValue = value;
+        saves++;
+        return hostBroker.sessionOpen;
+    }
+
+    AdafruitIODataCallbackType messageCallback = nullptr;
+};
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setTimeout(unsigned long ms) { timeout = ms; }
+    unsigned long timeout = 5000;
+};
+
+// The library's MQTT connect codes: 0 ok, 4/5 credentials rejected, -1 no connection
+class Adafruit_MQTT {
+public:
+    int8_t connect(const char* username, const char* password) {
+        hostBroker.connectAttempts++;
+        delay(hostBroker.connectMillis);
+        if (!hostBroker.reachable) {
+            return -1;
+        }
+        if (!hostBroker.acceptCredentials) {
+            return 4;
+        }
+        hostBroker.sessions++;
+        hostBroker.sessionOpen = true;
+        return 0;
+    }
+    bool connected() { return hostBroker.sessionOpen && hostBroker.reachable; }
+    bool processPackets(int16_t timeout) { return true; }
+    bool ping(uint8_t tries = 1) {
+        hostBroker.pings++;
+        return connected();
+    }
+    bool disconnect() {
+        hostBroker.sessionOpen = false;
+        return true;
+    }
+};
+
+class AdafruitIO_WiFi {
+public:
+    AdafruitIO_WiFi(const char* user, const char* key, const char* ssid, const char* pass)
+        : _username(user), _key(key) {
+        _mqtt = &mqtt;
+        _client = &client;
+    }
+    virtual ~AdafruitIO_WiFi() {}
+
+    AdafruitIO_Feed* feed(const char* name) {
+        if (feedCount >= HOST_IO_FEED_MAX) {
+            return nullptr;
+        }
+        feeds[feedCount].name = name;
+        return &feeds[feedCount++];
+    }
+
+    AdafruitIO_Feed feeds[HOST_IO_FEED_MAX];
+    uint8_t feedCount = 0;
+
+protected:
+    Adafruit_MQTT* _mqtt;
+    WiFiClientSecure* _client;
+    const char* _username;
+    const char* _key;
+
+private:
+    Adafruit_MQTT mqtt;
+    WiFiClientSecure client;
+};
+
+#endif
@@ -0,0 +1,202 @@
+// ArduinoJson.h
+// Host subset of ArduinoJson 6 for the command parsers: a document is one
+// flat object of strings, numbers, booleans and nulls. Nested values are
+// rejected as invalid input, which the firmware's commands never send.
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+#include <Arduino.h>
+#include <string>
+#include <type_traits>
+
+#define HOST_JSON_MEMBER_MAX 16
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory };
+
+    DeserializationError(Code code = Ok) : code(code) {}
+    explicit operator bool() const { return code != Ok; }
+    bool operator==(Code other) const { return code == other; }
+    const char* c_str() const {
+        static const char* names[] = {"Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory"};
+        return names[code];
+    }
+    const __FlashStringHelper* f_str() const { return F(c_str()); }
+
+private:
+    Code code;
+};
+
+class JsonVariantConst {
+public:
+    enum Kind { NONE, NUL, BOOLEAN, NUMBER, STRING };
+
+    JsonVariantConst() {}
+    JsonVariantConst(Kind kind, const std::string* text, double number) : kind(kind), text(text), number(number) {}
+
+    bool isNull() const { return kind == NONE || kind == NUL; }
+
+    template <typename T>
+    T as() const { return convert<T>(); }
+
+    template <typename T>
+    operator T() const { return convert<T>(); }
+
+private:
+    template <typename T>
+    typename std::enable_if<std::is_same<T, const char*>::value, T>::type convert() const {
+        return kind == STRING ? text->c_str() : nullptr;
+    }
+    template <typename T>
+    typename std::enable_if<std::is_same<T, bool>::value, T>::type convert() const {
+        return (kind == BOOLEAN || kind == NUMBER) && number != 0;
+    }
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, T>::type convert() const {
+        return kind == NUMBER || kind == BOOLEAN ? static_cast<T>(number) : T();
+    }
+
+    Kind kind = NONE;
+    const std::string* text = nullptr;
+    double number = 0;
+};
+
+class JsonDocument {
+public:
+    bool containsKey(const char* key) const { return find(key) >= 0; }
+    JsonVariantConst operator[](const char* key) const {
+        int index = find(key);
+        if (index < 0) {
+            return JsonVariantConst();
+        }
+        return JsonVariantConst(members[index].kind, &members[index].text, members[index].number);
+    }
+    size_t size() const { return count; }
+    void clear() { count = 0; }
+
+    DeserializationError parse(const char* input);
+
+private:
+    struct Member {
+        std::string key;
+        JsonVariantConst::Kind kind;
+        std::string text;
+        double number;
+    };
+
+    int find(const char* key) const {
+        for (size_t i = 0; i < count; i++) {
+            if (members[i].key == key) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    Member members[HOST_JSON_MEMBER_MAX];
+    size_t count = 0;
+};
+
+template <size_t capacity>
+class StaticJsonDocument : public JsonDocument {};
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+    return doc.parse(input);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* input) {
+    return doc.parse(reinterpret_cast<const char*>(input));
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input) {
+    return doc.parse(input.c_str());
+}
+
+inline DeserializationError JsonDocument::parse(const char* p) {
+    count = 0;
+    auto skip = [&p]() {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        }
+    };
+    auto parseString = [&p](std::string& out) {
+        out.clear();
+        p++; // Opening quote
+        while (*p && *p != '"') {
+            if (*p == '\\' && p[1]) {
+                p++;
+            }
+            out += *p++;
+        }
+        if (*p != '"') {
+            return false;
+        }
+        p++;
+        return true;
+    };
+
+    skip();
+    if (!*p) {
+        return DeserializationError::EmptyInput;
+    }
+    if (*p++ != '{') {
+        return DeserializationError::InvalidInput;
+    }
+    skip();
+    if (*p == '}') {
+        return DeserializationError::Ok;
+    }
+
+    while (true) {
+        skip();
+        if (*p != '"') {
+            return *p ? DeserializationError::InvalidInput : DeserializationError::IncompleteInput;
+        }
+        if (count == HOST_JSON_MEMBER_MAX) {
+            return DeserializationError::NoMemory;
+        }
+        Member& member = members[count];
+        if (!parseString(member.key)) {
+            return DeserializationError::IncompleteInput;
+        }
+        skip();
+        if (*p++ != ':') {
+            return DeserializationError::InvalidInput;
+        }
+        skip();
+
+        member.number = 0;
+        if (*p == '"') {
+            member.kind = JsonVariantConst::STRING;
+            if (!parseString(member.text)) {
+                return DeserializationError::IncompleteInput;
+            }
+        } else if (strncmp(p, "true", 4) == 0 || strncmp(p, "false", 5) == 0) {
+            member.kind = JsonVariantConst::BOOLEAN;
+            member.number = *p == 't';
+            p += *p == 't' ? 4 : 5;
+        } else if (strncmp(p, "null", 4) == 0) {
+            member.kind = JsonVariantConst::NUL;
+            p += 4;
+        } else {
+            char* end;
+            member.number = strtod(p, &end);
+            if (end == p) {
+                return *p ? DeserializationError::InvalidInput : DeserializationError::IncompleteInput;
+            }
+            member.kind = JsonVariantConst::NUMBER;
+            p = end;
+        }
+        count++;
+
+        skip();
+        if (*p == ',') {
+            p++;
+        } else if (*p == '}') {
+            return DeserializationError::Ok;
+        } else {
+            return *p ? DeserializationError::InvalidInput : DeserializationError::IncompleteInput;
+        }
+    }
+}
+
+#endif
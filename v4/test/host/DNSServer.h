@@ -0,0 +1,15 @@
+// DNSServer.h
+// Host DNS server: the captive portal's DNS never sees traffic on the host
+#ifndef HOST_DNSSERVER_H
+#define HOST_DNSSERVER_H
+
+#include <ESP8266WiFi.h>
+
+class DNSServer {
+public:
+    bool start(uint16_t port, const String& domainName, const IPAddress& resolvedIP) { return true; }
+    void processNextRequest() {}
+    void stop() {}
+};
+
+#endif
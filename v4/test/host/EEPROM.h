@@ -0,0 +1,47 @@
+// EEPROM.h
+// Host EEPROM emulation with the core's semantics: begin() copies the
+// first size bytes of the EEPROM flash sector into RAM, commit() erases
+// the whole sector and writes back only those bytes
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+    void begin(size_t size);
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    bool commit();
+    bool end();
+    uint8_t* getDataPtr();
+    size_t length() const { return size; }
+
+    template <typename T>
+    T& get(int address, T& value) {
+        if (address >= 0 && address + sizeof(T) <= size) {
+            memcpy(&value, data + address, sizeof(T));
+        }
+        return value;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& value) {
+        if (address >= 0 && address + sizeof(T) <= size) {
+            memcpy(data + address, &value, sizeof(T));
+            dirty = true;
+        }
+        return value;
+    }
+
+    uint32_t commits = 0;
+
+private:
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    bool dirty = false;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,193 @@
+// ESP8266WebServer.h
+// Host web server: routes are registered as on the device and requests
+// are dispatched synchronously by hostRequest(), which returns what the
+// handler sent
+#ifndef HOST_ESP8266WEBSERVER_H
+#define HOST_ESP8266WEBSERVER_H
+
+#include <ESP8266WiFi.h>
+#include <uri/UriBraces.h>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+typedef std::vector<std::pair<String, String>> HostHeaders;
+
+struct HostHttpResponse {
+    int code = 0;
+    String contentType;
+    std::string body;
+    HostHeaders headers;
+    bool chunked = false;
+
+    // Empty if the header was not sent
+    String header(const char* name) const {
+        for (const auto& header : headers) {
+            if (header.first.equalsIgnoreCase(name)) {
+                return header.second;
+            }
+        }
+        return String();
+    }
+};
+
+class ESP8266WebServer {
+public:
+    typedef std::function<void()> THandlerFunction;
+
+    ESP8266WebServer(int port = 80) {}
+
+    void begin() {}
+    void handleClient() {}
+    void on(const Uri& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const Uri& uri, HTTPMethod method, THandlerFunction handler) {
+        routes.push_back(Route{std::shared_ptr<Uri>(uri.clone()), method, handler});
+    }
+    void onNotFound(THandlerFunction handler) { notFoundHandler = handler; }
+    void collectHeaders(const char* headerKeys[], size_t count) {}
+
+    String uri() { return requestUri; }
+    HTTPMethod method() { return requestMethod; }
+    String arg(const String& name) {
+        for (const auto& arg : requestArgs) {
+            if (arg.first == name) {
+                return arg.second;
+            }
+        }
+        return String();
+    }
+    bool hasArg(const String& name) {
+        for (const auto& arg : requestArgs) {
+            if (arg.first == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+    String pathArg(unsigned int index) { return index < pathArgs.size() ? pathArgs[index] : String(); }
+    String header(const String& name) {
+        for (const auto& header : requestHeaders) {
+            if (header.first.equalsIgnoreCase(name)) {
+                return header.second;
+            }
+        }
+        return String();
+    }
+    bool hasHeader(const String& name) { return header(name).length() > 0; }
+    WiFiClient client() { return WiFiClient(requestSocket); }
+
+    void sendHeader(const String& name, const String& value, bool first = false) {
+        if (first) {
+            pendingHeaders.insert(pendingHeaders.begin(), std::make_pair(name, value));
+        } else {
+            pendingHeaders.push_back(std::make_pair(name, value));
+        }
+    }
+    void setContentLength(size_t length) { contentLength = length; }
+    void send(int code, const char* contentType, const char* content, size_t length) {
+        response.code = code;
+        response.contentType = contentType ? contentType : "";
+        response.body.assign(content ? content : "", content ? length : 0);
+        response.headers.insert(response.headers.end(), pendingHeaders.begin(), pendingHeaders.end());
+        response.chunked = contentLength == CONTENT_LENGTH_UNKNOWN;
+        pendingHeaders.clear();
+        responses++;
+    }
+    void send(int code, const char* contentType = nullptr, const char* content = "") {
+        send(code, contentType, content, content ? strlen(content) : 0);
+    }
+    void send(int code, const char* contentType, const String& content) {
+        send(code, contentType, content.c_str(), content.length());
+    }
+    void send(int code, const String& contentType, const String& content) {
+        send(code, contentType.c_str(), content.c_str(), content.length());
+    }
+    void send_P(int code, const char* contentType, const char* content) { send(code, contentType, content); }
+    void send_P(int code, const char* contentType, const char* content, size_t length) {
+        send(code, contentType, content, length);
+    }
+    void sendContent(const char* content, size_t length) { response.body.append(content, length); }
+    void sendContent(const char* content) { sendContent(content, strlen(content)); }
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent_P(const char* content, size_t length) { sendContent(content, length); }
+
+    // Test side: runs the matching handler like handleClient() would for
+    // one request. A query string in uri becomes args; body becomes "plain".
+    HostHttpResponse hostRequest(HTTPMethod method, const char* uri, const char* body = nullptr,
+                                 const HostHeaders& headers = HostHeaders()) {
+        response = HostHttpResponse();
+        pendingHeaders.clear();
+        contentLength = 0;
+        requestMethod = method;
+        requestHeaders = headers;
+        requestArgs.clear();
+        requestSocket = std::make_shared<HostSocket>();
+
+        const char* query = strchr(uri, '?');
+        requestUri = query ? String(std::string(uri, query - uri)) : String(uri);
+        if (query) {
+            parseQuery(query + 1);
+        }
+        if (body) {
+            requestArgs.push_back(std::make_pair(String("plain"), String(body)));
+        }
+
+        for (auto& route : routes) {
+            if ((route.method == HTTP_ANY || route.method == method) && route.uri->canHandle(requestUri, pathArgs)) {
+                route.handler();
+                return response;
+            }
+        }
+        if (notFoundHandler) {
+            notFoundHandler();
+        } else {
+            send(404, "text/plain", "Not found");
+        }
+        return response;
+    }
+
+    std::shared_ptr<HostSocket> requestSocket; // Connection of the last request
+    uint32_t responses = 0;
+
+private:
+    struct Route {
+        std::shared_ptr<Uri> uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    void parseQuery(const char* query) {
+        while (*query) {
+            const char* end = strchr(query, '&');
+            std::string pair = end ? std::string(query, end - query) : std::string(query);
+            size_t equals = pair.find('=');
+            if (equals == std::string::npos) {
+                requestArgs.push_back(std::make_pair(String(pair), String()));
+            } else {
+                requestArgs.push_back(std::make_pair(String(pair.substr(0, equals)), String(pair.substr(equals + 1))));
+            }
+            if (!end) {
+                break;
+            }
+            query = end + 1;
+        }
+    }
+
+    std::vector<Route> routes;
+    THandlerFunction notFoundHandler;
+    String requestUri;
+    HTTPMethod requestMethod = HTTP_GET;
+    HostHeaders requestHeaders;
+    std::vector<std::pair<String, String>> requestArgs;
+    std::vector<String> pathArgs;
+    HostHeaders pendingHeaders;
+    size_t contentLength = 0;
+    HostHttpResponse response;
+};
+
+#endif
@@ -0,0 +1,157 @@
+// ESP8266WiFi.h
+// Host WiFi: the station status and events are driven by the test, and
+// WiFiClient is an in-memory socket with a bounded send buffer
+#ifndef HOST_ESP8266WIFI_H
+#define HOST_ESP8266WIFI_H
+
+#include <Arduino.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+#define HOST_TCP_SND_BUF 2920 // lwIP TCP_SND_BUF with the core's default MSS
+#define HOST_WRITE_TIMEOUT 5000 // WiFiClient default; a write to a full buffer waits this long
+
+class IPAddress {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : address(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+    operator uint32_t() const { return address; }
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", address & 0xFF, (address >> 8) & 0xFF,
+                 (address >> 16) & 0xFF, address >> 24);
+        return String(text);
+    }
+
+private:
+    uint32_t address = 0;
+};
+
+enum wl_status_t {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+};
+
+enum WiFiMode_t { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA };
+
+struct WiFiEventStationModeGotIP {
+    IPAddress ip;
+};
+
+struct WiFiEventStationModeDisconnected {
+    uint8_t reason;
+};
+
+struct HostWiFiEventHandler {};
+typedef std::shared_ptr<HostWiFiEventHandler> WiFiEventHandler;
+
+// The peer end of a connection. The firmware sees free buffer space;
+// the test decides how fast the peer drains it.
+struct HostSocket {
+    bool connected = true;
+    bool aborted = false;
+    size_t writable = HOST_TCP_SND_BUF;
+    std::string sent;
+    uint32_t writes = 0;
+    uint32_t stalls = 0; // Writes that had to wait for the peer
+
+    void drain() { writable = HOST_TCP_SND_BUF; }
+};
+
+class WiFiClient {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(std::shared_ptr<HostSocket> socket) : socket(socket) {}
+
+    bool connected() { return socket && socket->connected; }
+    explicit operator bool() { return connected(); }
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t availableForWrite() { return connected() ? socket->writable : 0; }
+    size_t write(const uint8_t* data, size_t length);
+    size_t write(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+    void flush() {}
+    void stop() {
+        if (socket) {
+            socket->connected = false;
+        }
+    }
+    void abort() {
+        if (socket) {
+            socket->connected = false;
+            socket->aborted = true;
+        }
+    }
+    void setNoDelay(bool) {}
+    void setTimeout(unsigned long) {}
+
+    std::shared_ptr<HostSocket> socket;
+};
+
+class ESP8266WiFiClass {
+public:
+    wl_status_t status() { return stationStatus; }
+    bool mode(WiFiMode_t value) { currentMode = value; return true; }
+    WiFiMode_t getMode() { return currentMode; }
+    wl_status_t begin(const char* ssid, const char* password) {
+        beginCalls++;
+        stationStatus = WL_DISCONNECTED;
+        return stationStatus;
+    }
+    bool disconnect(bool wifiOff = false) {
+        disconnectCalls++;
+        stationStatus = WL_DISCONNECTED;
+        return true;
+    }
+    bool softAP(const char* ssid, const char* password = nullptr) { return true; }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    uint8_t softAPgetStationNum() { return softAPStations; }
+    IPAddress localIP() { return stationStatus == WL_CONNECTED ? IPAddress(192, 168, 1, 50) : IPAddress(); }
+    void persistent(bool) {}
+    bool setAutoConnect(bool) { return true; }
+    bool setAutoReconnect(bool) { return true; }
+    bool isConnected() { return stationStatus == WL_CONNECTED; }
+    int32_t RSSI() { return -60; }
+
+    WiFiEventHandler onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)> handler) {
+        gotIPHandler = handler;
+        return std::make_shared<HostWiFiEventHandler>();
+    }
+    WiFiEventHandler onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)> handler) {
+        disconnectedHandler = handler;
+        return std::make_shared<HostWiFiEventHandler>();
+    }
+
+    // Test side: what the SDK would report
+    void hostConnect() {
+        stationStatus = WL_CONNECTED;
+        if (gotIPHandler) {
+            gotIPHandler(WiFiEventStationModeGotIP());
+        }
+    }
+    void hostDisconnect(wl_status_t status = WL_DISCONNECTED) {
+        stationStatus = status;
+        if (disconnectedHandler) {
+            disconnectedHandler(WiFiEventStationModeDisconnected());
+        }
+    }
+
+    wl_status_t stationStatus = WL_IDLE_STATUS;
+    WiFiMode_t currentMode = WIFI_OFF;
+    uint8_t softAPStations = 0;
+    uint32_t beginCalls = 0;
+    uint32_t disconnectCalls = 0;
+
+private:
+    std::function<void(const WiFiEventStationModeGotIP&)> gotIPHandler;
+    std::function<void(const WiFiEventStationModeDisconnected&)> disconnectedHandler;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,19 @@
+// ESP8266mDNS.h
+// Host mDNS responder: records the hostname only
+#ifndef HOST_ESP8266MDNS_H
+#define HOST_ESP8266MDNS_H
+
+#include <ESP8266WiFi.h>
+
+class MDNSResponder {
+public:
+    bool begin(const char* name) { hostname = name; return true; }
+    bool addService(const char* service, const char* protocol, uint16_t port) { return true; }
+    bool update() { return true; }
+
+    String hostname;
+};
+
+extern MDNSResponder MDNS;
+
+#endif
@@ -0,0 +1,38 @@
+// Ticker.h
+// Host Ticker: one-shot callbacks fire from hostAdvanceMicros() once the
+// simulated clock reaches them, standing in for the timer interrupt
+#ifndef HOST_TICKER_H
+#define HOST_TICKER_H
+
+#include <Arduino.h>
+#include <functional>
+
+class Ticker {
+public:
+    Ticker();
+    ~Ticker();
+
+    void once_ms(uint32_t ms, void (*callback)()) {
+        arm(ms, callback);
+    }
+
+    template <typename TArg>
+    void once_ms(uint32_t ms, void (*callback)(TArg), TArg arg) {
+        arm(ms, [callback, arg]() { callback(arg); });
+    }
+
+    void detach() { armed = false; }
+    bool active() const { return armed; }
+
+    // Fires this ticker if it is due; called by hostFireTickers()
+    void fireIfDue(uint64_t nowMicros);
+
+private:
+    void arm(uint32_t ms, std::function<void()> callback);
+
+    std::function<void()> pending;
+    uint64_t dueMicros = 0;
+    bool armed = false;
+};
+
+#endif
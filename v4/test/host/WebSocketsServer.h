@@ -0,0 +1,166 @@
+// WebSocketsServer.h
+// Host WebSocket server with the library's client table layout. Clients
+// are connected and fed messages by the test; frames are written to the
+// client's HostSocket, so a full send buffer stalls the sender as it
+// would on the device.
+#ifndef HOST_WEBSOCKETSSERVER_H
+#define HOST_WEBSOCKETSSERVER_H
+
+#include <ESP8266WiFi.h>
+#include "host.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+enum WStype_t {
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_PING,
+    WStype_PONG
+};
+
+struct WSclient_t {
+    uint8_t num;
+    WiFiClient* tcp;
+    String cProtocol;
+};
+
+struct HostWsMessage {
+    bool binary;
+    std::string payload;
+};
+
+class WebSocketsServer {
+public:
+    typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+    typedef std::function<bool(String headerName, String headerValue)> WebSocketServerHttpHeaderValFunc;
+
+    WebSocketsServer(uint16_t port, const String& origin = "", const String& protocol = "arduino") {
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+            _clients[num].num = num;
+            _clients[num].tcp = nullptr;
+        }
+    }
+    virtual ~WebSocketsServer() {
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+            delete _clients[num].tcp;
+        }
+    }
+
+    void begin() {}
+    void onEvent(WebSocketServerEvent handler) { eventHandler = handler; }
+    void onValidateHttpHeader(WebSocketServerHttpHeaderValFunc validator, const char* mandatoryHttpHeaders[], size_t count) {
+        headerValidator = validator;
+    }
+
+    // Reaps clients whose connection went away, as the library does
+    void loop() {
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+            if (_clients[num].tcp && !_clients[num].tcp->connected()) {
+                clientDisconnect(num);
+            }
+        }
+    }
+
+    bool sendTXT(uint8_t num, const char* payload, size_t length = 0) {
+        return sendFrame(num, false, reinterpret_cast<const uint8_t*>(payload), length ? length : strlen(payload));
+    }
+    bool sendTXT(uint8_t num, const String& payload) { return sendTXT(num, payload.c_str(), payload.length()); }
+    bool sendBIN(uint8_t num, const uint8_t* payload, size_t length) { return sendFrame(num, true, payload, length); }
+
+    void disconnect(uint8_t num) {
+        if (clientIsConnected(num)) {
+            static const uint8_t closeFrame[] = {0x88, 0x02, 0x03, 0xE8};
+            _clients[num].tcp->write(closeFrame, sizeof(closeFrame));
+            clientDisconnect(num);
+        }
+    }
+    bool clientIsConnected(uint8_t num) {
+        return num < WEBSOCKETS_SERVER_CLIENT_MAX && _clients[num].tcp && _clients[num].tcp->connected();
+    }
+    uint8_t connectedClients(bool ping = false) {
+        uint8_t count = 0;
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+            count += clientIsConnected(num);
+        }
+        return count;
+    }
+    IPAddress remoteIP(uint8_t num) { return IPAddress(192, 168, 1, 100 + num); }
+
+    // Test side. Returns the socket, or nullptr if the handshake was refused.
+    std::shared_ptr<HostSocket> hostConnect(uint8_t num, const char* protocol = "", const char* url = "/") {
+        if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || _clients[num].tcp) {
+            return nullptr;
+        }
+        if (*protocol && headerValidator && !headerValidator("Sec-WebSocket-Protocol", protocol)) {
+            return nullptr;
+        }
+        std::shared_ptr<HostSocket> socket = std::make_shared<HostSocket>();
+        _clients[num].tcp = new WiFiClient(socket);
+        _clients[num].cProtocol = protocol;
+        hostSent[num].clear();
+        if (eventHandler) {
+            std::string payload(url);
+            eventHandler(num, WStype_CONNECTED, reinterpret_cast<uint8_t*>(&payload[0]), payload.size());
+        }
+        return socket;
+    }
+    void hostReceive(uint8_t num, bool binary, const void* payload, size_t length) {
+        // Copied like the library's receive buffer, and without allocating
+        // so the test's own strings stay out of the heap figures
+        if (eventHandler && clientIsConnected(num) && length < sizeof(receiveBuffer)) {
+            memcpy(receiveBuffer, payload, length);
+            receiveBuffer[length] = 0;
+            eventHandler(num, binary ? WStype_BIN : WStype_TEXT, receiveBuffer, length);
+        }
+    }
+    void hostReceiveText(uint8_t num, const char* text) { hostReceive(num, false, text, strlen(text)); }
+
+    std::vector<HostWsMessage> hostSent[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+protected:
+    WSclient_t _clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+private:
+    bool sendFrame(uint8_t num, bool binary, const uint8_t* payload, size_t length) {
+        if (!clientIsConnected(num)) {
+            return false;
+        }
+        uint8_t header[4] = {static_cast<uint8_t>(binary ? 0x82 : 0x81), 0, 0, 0};
+        size_t headerLength = 2;
+        if (length < 126) {
+            header[1] = length;
+        } else {
+            header[1] = 126;
+            header[2] = length >> 8;
+            header[3] = length & 0xFF;
+            headerLength = 4;
+        }
+        WiFiClient* tcp = _clients[num].tcp;
+        bool ok = tcp->write(header, headerLength) == headerLength && tcp->write(payload, length) == length;
+        if (hostKeepOutput) {
+            hostSent[num].push_back(HostWsMessage{binary, std::string(reinterpret_cast<const char*>(payload), length)});
+        }
+        return ok;
+    }
+
+    void clientDisconnect(uint8_t num) {
+        delete _clients[num].tcp;
+        _clients[num].tcp = nullptr;
+        _clients[num].cProtocol = String();
+        if (eventHandler) {
+            eventHandler(num, WStype_DISCONNECTED, nullptr, 0);
+        }
+    }
+
+    WebSocketServerEvent eventHandler;
+    WebSocketServerHttpHeaderValFunc headerValidator;
+    uint8_t receiveBuffer[1024];
+};
+
+#endif
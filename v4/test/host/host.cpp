@@ -0,0 +1,518 @@
+// host.cpp
+#include "host.h"
+#include <EEPROM.h>
+#include <ESP8266WiFi.h>
+#include <ESP8266mDNS.h>
+#include <AdafruitIO_WiFi.h>
+#include <Ticker.h>
+#include <new>
+
+// The EEPROM sector's address in the flash mapping, as the linker script
+// places it for the 1M "FS: none" layout
+asm(".globl _EEPROM_start\n.set _EEPROM_start, 0x402FB000");
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+ESP8266WiFiClass WiFi;
+MDNSResponder MDNS;
+HostBroker hostBroker;
+HostGpoRegister hostGpo;
+
+HostFlashStats hostFlashStats;
+HostHeapStats hostHeapStats;
+uint32_t hostRestarts = 0;
+bool hostKeepOutput = true;
+
+// Clock
+
+static uint64_t nowMicros = 0;
+
+unsigned long millis() {
+    return static_cast<uint32_t>(nowMicros / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<uint32_t>(nowMicros);
+}
+
+uint64_t hostMicros() {
+    return nowMicros;
+}
+
+void hostSetMicros(uint64_t now) {
+    nowMicros = now;
+}
+
+void hostAdvanceMicros(uint64_t us) {
+    nowMicros += us;
+    hostFireTickers();
+}
+
+void hostAdvanceMillis(uint64_t ms) {
+    hostAdvanceMicros(ms * 1000);
+}
+
+void delay(unsigned long ms) {
+    hostAdvanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostAdvanceMicros(us);
+}
+
+void yield() {}
+
+// Tickers
+
+static std::vector<Ticker*>& tickers() {
+    static std::vector<Ticker*> list;
+    return list;
+}
+
+Ticker::Ticker() {
+    tickers().push_back(this);
+}
+
+Ticker::~Ticker() {
+    std::vector<Ticker*>& list = tickers();
+    list.erase(std::remove(list.begin(), list.end(), this), list.end());
+}
+
+void Ticker::arm(uint32_t ms, std::function<void()> callback) {
+    pending = callback;
+    dueMicros = nowMicros + ms * 1000ULL;
+    armed = true;
+}
+
+void Ticker::fireIfDue(uint64_t now) {
+    if (armed && now >= dueMicros) {
+        armed = false;
+        pending();
+    }
+}
+
+void hostFireTickers() {
+    // A callback may arm another ticker; index so the list can grow
+    for (size_t i = 0; i < tickers().size(); i++) {
+        tickers()[i]->fireIfDue(nowMicros);
+    }
+}
+
+// GPIO
+
+#define HOST_PIN_COUNT 17
+
+struct HostPin {
+    uint8_t mode;
+    uint8_t level;     // Driven level
+    uint8_t input;     // Level seen when not an output
+    void (*handler)(void*);
+    void* arg;
+};
+
+static HostPin pins[HOST_PIN_COUNT];
+static std::vector<HostPinEvent> pinEvents;
+static int (*analogSource)(uint8_t) = nullptr;
+
+void hostResetPins() {
+    for (uint8_t pin = 0; pin < HOST_PIN_COUNT; pin++) {
+        // Reset state: inputs, and the pull-ups leave relay lines reading high
+        pins[pin] = HostPin{INPUT, HIGH, HIGH, nullptr, nullptr};
+    }
+    pinEvents.clear();
+}
+
+static void setLevel(uint8_t pin, uint8_t level) {
+    if (pin < HOST_PIN_COUNT) {
+        pins[pin].level = level ? HIGH : LOW;
+        if (hostKeepOutput) {
+            pinEvents.push_back(HostPinEvent{HostPinEvent::LEVEL, pin, pins[pin].level});
+        }
+    }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < HOST_PIN_COUNT) {
+        pins[pin].mode = mode;
+        if (hostKeepOutput) {
+            pinEvents.push_back(HostPinEvent{HostPinEvent::MODE, pin, mode});
+        }
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    setLevel(pin, value);
+}
+
+int digitalRead(uint8_t pin) {
+    if (pin >= HOST_PIN_COUNT) {
+        return LOW;
+    }
+    return pins[pin].mode == OUTPUT ? pins[pin].level : pins[pin].input;
+}
+
+HostGpoRegister::operator uint32_t() const {
+    uint32_t value = 0;
+    for (uint8_t pin = 0; pin < 16; pin++) {
+        value |= static_cast<uint32_t>(pins[pin].level) << pin;
+    }
+    return value;
+}
+
+HostGpoRegister& HostGpoRegister::operator=(uint32_t value) {
+    uint32_t current = *this;
+    for (uint8_t pin = 0; pin < 16; pin++) {
+        if (((current ^ value) >> pin) & 1) {
+            setLevel(pin, (value >> pin) & 1);
+        }
+    }
+    return *this;
+}
+
+uint8_t hostPinLevel(uint8_t pin) {
+    return pin < HOST_PIN_COUNT ? pins[pin].level : LOW;
+}
+
+uint8_t hostPinMode(uint8_t pin) {
+    return pin < HOST_PIN_COUNT ? pins[pin].mode : INPUT;
+}
+
+void hostSetInput(uint8_t pin, uint8_t level) {
+    if (pin < HOST_PIN_COUNT) {
+        pins[pin].input = level;
+    }
+}
+
+const std::vector<HostPinEvent>& hostPinEvents() {
+    return pinEvents;
+}
+
+void hostClearPinEvents() {
+    pinEvents.clear();
+}
+
+int analogRead(uint8_t pin) {
+    return analogSource ? constrain(analogSource(pin), 0, 1023) : 0;
+}
+
+void analogWrite(uint8_t pin, int value) {}
+
+void hostSetAnalogSource(int (*source)(uint8_t pin)) {
+    analogSource = source;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+int digitalPinToInterrupt(uint8_t pin) {
+    return pin;
+}
+
+static void callPlainHandler(void* handler) {
+    reinterpret_cast<void (*)()>(handler)();
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode) {
+    attachInterruptArg(interrupt, callPlainHandler, reinterpret_cast<void*>(handler), mode);
+}
+
+void attachInterruptArg(uint8_t interrupt, void (*handler)(void*), void* arg, int mode) {
+    if (interrupt < HOST_PIN_COUNT) {
+        pins[interrupt].handler = handler;
+        pins[interrupt].arg = arg;
+    }
+}
+
+void detachInterrupt(uint8_t interrupt) {
+    if (interrupt < HOST_PIN_COUNT) {
+        pins[interrupt].handler = nullptr;
+    }
+}
+
+bool hostInterruptAttached(uint8_t pin) {
+    return pin < HOST_PIN_COUNT && pins[pin].handler != nullptr;
+}
+
+void hostFireInterrupt(uint8_t pin) {
+    if (hostInterruptAttached(pin)) {
+        pins[pin].handler(pins[pin].arg);
+    }
+}
+
+// Random numbers: deterministic so test runs repeat
+
+static uint32_t randomState = 1;
+
+void hostSeedRandom(uint32_t seed) {
+    randomState = seed ? seed : 1;
+}
+
+static uint32_t nextRandom() {
+    // xorshift32
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+long random(long howBig) {
+    return howBig > 0 ? nextRandom() % howBig : 0;
+}
+
+long random(long howSmall, long howBig) {
+    return howBig > howSmall ? howSmall + random(howBig - howSmall) : howSmall;
+}
+
+void randomSeed(unsigned long seed) {
+    hostSeedRandom(seed);
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+// Serial
+
+static std::string serialOutput;
+
+size_t HardwareSerial::print(const char* text) {
+    if (hostKeepOutput) {
+        serialOutput += text;
+    }
+    if (getenv("HOST_SERIAL")) {
+        fputs(text, stdout);
+    }
+    return strlen(text);
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return print(buffer);
+}
+
+const std::string& hostSerialOutput() {
+    return serialOutput;
+}
+
+void hostClearSerialOutput() {
+    serialOutput.clear();
+}
+
+// Flash and RTC memory
+
+static uint8_t flash[HOST_FLASH_SIZE];
+static uint8_t rtcMemory[HOST_RTC_USER_MEMORY_SIZE];
+
+static struct HostMemoryInit {
+    HostMemoryInit() {
+        memset(flash, 0xFF, sizeof(flash));
+        hostResetPins();
+    }
+} hostMemoryInit;
+
+uint8_t* hostFlash() {
+    return flash;
+}
+
+void hostEraseFlash() {
+    memset(flash, 0xFF, sizeof(flash));
+    hostFlashStats = HostFlashStats();
+}
+
+uint8_t* hostRtcMemory() {
+    return rtcMemory;
+}
+
+void hostClearRtcMemory() {
+    // Power-on contents are random; all-ones never passes a CRC check here
+    memset(rtcMemory, 0xA5, sizeof(rtcMemory));
+}
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+    if ((sector + 1) * SPI_FLASH_SEC_SIZE > HOST_FLASH_SIZE) {
+        return false;
+    }
+    memset(flash + sector * SPI_FLASH_SEC_SIZE, 0xFF, SPI_FLASH_SEC_SIZE);
+    hostFlashStats.sectorErases++;
+    hostAdvanceMicros(HOST_FLASH_ERASE_US);
+    return true;
+}
+
+bool EspClass::flashWrite(uint32_t address, const uint32_t* data, size_t size) {
+    // The SDK takes 4-byte aligned addresses and lengths
+    if ((address & 3) || (size & 3) || address + size > HOST_FLASH_SIZE) {
+        return false;
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        flash[address + i] &= bytes[i]; // Programming only clears bits
+    }
+    hostFlashStats.writes++;
+    hostFlashStats.bytesWritten += size;
+    hostAdvanceMicros(HOST_FLASH_PROGRAM_SETUP_US + size * HOST_FLASH_PAGE_PROGRAM_US / 256);
+    return true;
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t* data, size_t size) {
+    if ((address & 3) || (size & 3) || address + size > HOST_FLASH_SIZE) {
+        return false;
+    }
+    memcpy(data, flash + address, size);
+    hostFlashStats.reads++;
+    return true;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size) {
+    if (offset * 4 + size > HOST_RTC_USER_MEMORY_SIZE || (size & 3)) {
+        return false;
+    }
+    memcpy(data, rtcMemory + offset * 4, size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size) {
+    if (offset * 4 + size > HOST_RTC_USER_MEMORY_SIZE || (size & 3)) {
+        return false;
+    }
+    memcpy(rtcMemory + offset * 4, data, size);
+    return true;
+}
+
+void EspClass::restart() {
+    hostRestarts++;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return HOST_HEAP_SIZE - min<size_t>(hostHeapStats.liveBytes, HOST_HEAP_SIZE);
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+    return getFreeHeap(); // No fragmentation model
+}
+
+uint8_t EspClass::getHeapFragmentation() {
+    return 0;
+}
+
+uint32_t EspClass::getCycleCount() {
+    return static_cast<uint32_t>(nowMicros * 80); // 80 MHz
+}
+
+uint32_t EspClass::random() {
+    return nextRandom();
+}
+
+// EEPROM, on top of the emulated flash like the core's
+
+void EEPROMClass::begin(size_t newSize) {
+    newSize = (newSize + 3) & ~3;
+    if (newSize > SPI_FLASH_SEC_SIZE) {
+        newSize = SPI_FLASH_SEC_SIZE;
+    }
+    delete[] data;
+    data = new uint8_t[newSize];
+    size = newSize;
+    dirty = false;
+    ESP.flashRead(HOST_EEPROM_SECTOR * SPI_FLASH_SEC_SIZE, reinterpret_cast<uint32_t*>(data), size);
+}
+
+uint8_t EEPROMClass::read(int address) {
+    return address >= 0 && static_cast<size_t>(address) < size ? data[address] : 0;
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (address >= 0 && static_cast<size_t>(address) < size && data[address] != value) {
+        data[address] = value;
+        dirty = true;
+    }
+}
+
+bool EEPROMClass::commit() {
+    if (!data || !dirty) {
+        return data != nullptr;
+    }
+    commits++;
+    dirty = false;
+    return ESP.flashEraseSector(HOST_EEPROM_SECTOR) &&
+           ESP.flashWrite(HOST_EEPROM_SECTOR * SPI_FLASH_SEC_SIZE, reinterpret_cast<uint32_t*>(data), size);
+}
+
+bool EEPROMClass::end() {
+    bool ok = commit();
+    delete[] data;
+    data = nullptr;
+    size = 0;
+    return ok;
+}
+
+uint8_t* EEPROMClass::getDataPtr() {
+    dirty = true;
+    return data;
+}
+
+// Sockets: a write the send buffer can't take waits out the client
+// timeout, then sends what fits
+
+size_t WiFiClient::write(const uint8_t* data, size_t length) {
+    if (!connected()) {
+        return 0;
+    }
+    size_t written = length;
+    if (length > socket->writable) {
+        socket->stalls++;
+        delay(HOST_WRITE_TIMEOUT);
+        written = socket->writable;
+    }
+    if (hostKeepOutput) {
+        socket->sent.append(reinterpret_cast<const char*>(data), written);
+    }
+    socket->writable -= written;
+    socket->writes++;
+    return written;
+}
+
+// Heap accounting for every C++ allocation in the process. The size is
+// kept in front of the block so frees can be counted too.
+
+void* operator new(size_t size) {
+    size_t* block = static_cast<size_t*>(malloc(size + sizeof(size_t) * 2));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    block[0] = size;
+    hostHeapStats.allocations++;
+    hostHeapStats.liveBytes += size;
+    hostHeapStats.peakBytes = max(hostHeapStats.peakBytes, hostHeapStats.liveBytes);
+    return block + 2;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    size_t* block = static_cast<size_t*>(pointer) - 2;
+    hostHeapStats.frees++;
+    hostHeapStats.liveBytes -= block[0];
+    free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void* pointer) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
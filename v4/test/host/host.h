@@ -0,0 +1,83 @@
+// host.h
+// Controls for the simulated hardware behind the host Arduino core
+#ifndef HOST_H
+#define HOST_H
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// Flash: 1 MB, erased to 0xFF, writes can only clear bits like NOR flash.
+// The EEPROM sector sits where the 1M "FS: none" layout puts it.
+#define HOST_FLASH_SIZE 0x100000
+#define HOST_EEPROM_SECTOR 0xFB
+#define HOST_RTC_USER_MEMORY_SIZE 512
+#define HOST_HEAP_SIZE 40000 // Roughly what a WiFi sketch has free after boot
+
+// Flash timing, typical figures for the 25Q-series parts on ESP-12 modules.
+// Erases and writes advance the simulated clock by this much.
+#define HOST_FLASH_ERASE_US 45000
+#define HOST_FLASH_PROGRAM_SETUP_US 20
+#define HOST_FLASH_PAGE_PROGRAM_US 700 // Per 256-byte page
+
+struct HostFlashStats {
+    uint32_t sectorErases;
+    uint32_t writes;
+    uint32_t bytesWritten;
+    uint32_t reads;
+};
+
+struct HostHeapStats {
+    uint32_t allocations;
+    uint32_t frees;
+    size_t liveBytes;
+    size_t peakBytes;
+};
+
+// One GPIO change, in the order the firmware made them
+struct HostPinEvent {
+    enum Kind { MODE, LEVEL } kind;
+    uint8_t pin;
+    uint8_t value;
+};
+
+// Clock
+void hostSetMicros(uint64_t now); // Absolute; millis() is derived and wraps like the core
+void hostAdvanceMicros(uint64_t us); // Also fires Tickers that fall due
+void hostAdvanceMillis(uint64_t ms);
+uint64_t hostMicros();
+
+// Flash and RTC memory
+uint8_t* hostFlash();
+extern HostFlashStats hostFlashStats;
+void hostEraseFlash();
+void hostClearRtcMemory(); // Power loss: RTC user memory is lost, flash stays
+uint8_t* hostRtcMemory();
+
+// GPIO and ADC
+void hostResetPins();
+uint8_t hostPinLevel(uint8_t pin);
+uint8_t hostPinMode(uint8_t pin);
+void hostSetInput(uint8_t pin, uint8_t level); // Level seen by digitalRead() on an input
+const std::vector<HostPinEvent>& hostPinEvents();
+void hostClearPinEvents();
+void hostFireInterrupt(uint8_t pin); // Runs the attached handler, if any
+bool hostInterruptAttached(uint8_t pin);
+void hostSetAnalogSource(int (*source)(uint8_t pin));
+
+// Heap: C++ allocations through operator new are counted
+extern HostHeapStats hostHeapStats;
+// Off: serial output, socket data, WebSocket messages and pin events are
+// not kept, so the heap figures are the firmware's own
+extern bool hostKeepOutput;
+
+// Misc
+extern uint32_t hostRestarts;
+void hostSeedRandom(uint32_t seed);
+const std::string& hostSerialOutput();
+void hostClearSerialOutput();
+
+// Ticker support, see Ticker.h
+void hostFireTickers();
+
+#endif
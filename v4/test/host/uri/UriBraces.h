@@ -0,0 +1,52 @@
+// uri/UriBraces.h
+// Host route patterns: plain URIs match exactly, "{}" matches one path segment
+#ifndef HOST_URI_BRACES_H
+#define HOST_URI_BRACES_H
+
+#include <Arduino.h>
+#include <vector>
+
+class Uri {
+public:
+    Uri(const char* uri) : pattern(uri) {}
+    Uri(const String& uri) : pattern(uri.c_str()) {}
+    virtual ~Uri() {}
+
+    virtual Uri* clone() const { return new Uri(*this); }
+    virtual bool canHandle(const String& requestUri, std::vector<String>& pathArgs) {
+        return pattern == requestUri.c_str();
+    }
+
+protected:
+    std::string pattern;
+};
+
+class UriBraces : public Uri {
+public:
+    UriBraces(const char* uri) : Uri(uri) {}
+    UriBraces(const String& uri) : Uri(uri) {}
+
+    Uri* clone() const override { return new UriBraces(*this); }
+    bool canHandle(const String& requestUri, std::vector<String>& pathArgs) override {
+        pathArgs.clear();
+        const char* uri = requestUri.c_str();
+        size_t pos = 0;
+        while (pos < pattern.size()) {
+            if (pattern.compare(pos, 2, "{}") == 0) {
+                const char* end = strchr(uri, '/');
+                size_t length = end ? static_cast<size_t>(end - uri) : strlen(uri);
+                pathArgs.push_back(String(std::string(uri, length)));
+                uri += length;
+                pos += 2;
+            } else if (*uri == pattern[pos]) {
+                uri++;
+                pos++;
+            } else {
+                return false;
+            }
+        }
+        return *uri == '\0';
+    }
+};
+
+#endif
@@ -0,0 +1,57 @@
+// runner.cpp
+#include "test.h"
+
+static TestCase* firstTest = nullptr;
+static TestCase* lastTest = nullptr;
+static int failures = 0;
+
+TestRegistrar::TestRegistrar(TestCase* test) {
+    // Keep file order so cases run top to bottom
+    if (lastTest) {
+        lastTest->next = test;
+    } else {
+        firstTest = test;
+    }
+    lastTest = test;
+}
+
+void testFailed(const char* file, int line, const char* expression) {
+    printf("    %s:%d: CHECK(%s) failed\n", file, line, expression);
+    failures++;
+}
+
+void testFailedValues(const char* file, int line, const char* expression, double actual, double expected) {
+    printf("    %s:%d: CHECK(%s) failed: got %g, expected %g\n", file, line, expression, actual, expected);
+    failures++;
+}
+
+void testReset() {
+    hostEraseFlash();
+    hostClearRtcMemory();
+    hostResetPins();
+    hostSetMicros(0);
+    hostSeedRandom(1);
+    hostClearSerialOutput();
+    hostKeepOutput = true;
+}
+
+int main(int argc, char** argv) {
+    int failedTests = 0;
+    int count = 0;
+    for (TestCase* test = firstTest; test; test = test->next) {
+        // An argument runs only the cases whose name contains it
+        if (argc > 1 && !strstr(test->name, argv[1])) {
+            continue;
+        }
+        int before = failures;
+        printf("%s\n", test->name);
+        testReset();
+        test->run();
+        count++;
+        if (failures != before) {
+            failedTests++;
+        }
+    }
+    printf("%d of %d passed\n", count - failedTests, count);
+    return failedTests == 0 ? 0 : 1;
+}
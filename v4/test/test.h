@@ -0,0 +1,82 @@
+// test.h
+// Minimal test harness for the host build
+// TEST(name) registers a case; the CHECK macros record a failure and let
+// the case continue. Each test_*.cpp links into its own binary, so module
+// state (task tables, event subscribers, the journal) starts fresh per
+// file. BENCH() is a TEST whose output is a measurement; the REPORT line
+// goes to stdout so runs can be compared.
+#ifndef TEST_H
+#define TEST_H
+
+#include "host.h"
+#include <chrono>
+#include <stdio.h>
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+    TestCase* next;
+};
+
+struct TestRegistrar {
+    TestRegistrar(TestCase* test);
+};
+
+void testFailed(const char* file, int line, const char* expression);
+void testFailedValues(const char* file, int line, const char* expression, double actual, double expected);
+void testReset(); // Fresh flash, RTC memory, pins and clock before each case
+
+#define TEST(name)                                                      \
+    static void name();                                                 \
+    static TestCase name##Case = {#name, name, nullptr};                \
+    static TestRegistrar name##Registrar(&name##Case);                  \
+    static void name()
+
+#define BENCH(name) TEST(name)
+
+#define CHECK(condition)                                                \
+    do {                                                                \
+        if (!(condition)) {                                             \
+            testFailed(__FILE__, __LINE__, #condition);                 \
+        }                                                               \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                      \
+    do {                                                                \
+        auto checkActual = (actual);                                    \
+        auto checkExpected = (expected);                                \
+        if (!(checkActual == checkExpected)) {                          \
+            testFailedValues(__FILE__, __LINE__, #actual " == " #expected, \
+                             (double)checkActual, (double)checkExpected); \
+        }                                                               \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                         \
+    do {                                                                \
+        double checkActual = (actual);                                  \
+        double checkExpected = (expected);                              \
+        if (fabs(checkActual - checkExpected) > (tolerance)) {          \
+            testFailedValues(__FILE__, __LINE__, #actual " ~ " #expected, \
+                             checkActual, checkExpected);               \
+        }                                                               \
+    } while (0)
+
+#define REPORT(...)                                                     \
+    do {                                                                \
+        printf("    ");                                                 \
+        printf(__VA_ARGS__);                                            \
+        printf("\n");                                                   \
+    } while (0)
+
+// Host CPU time per iteration of body, in nanoseconds
+template <typename Body>
+double nanosPerCall(uint32_t iterations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        body(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+#endif
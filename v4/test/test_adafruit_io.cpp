@@ -0,0 +1,183 @@
+// test_adafruit_io.cpp
+// The client is built once per boot, so these cases share one and run in
+// order; the rejected-credentials case disables it and comes last.
+#include "fixture.h"
+#include <vector>
+
+static std::vector<uint32_t> attemptTimes;
+
+static void startClient() {
+    static bool started = false;
+    configureRelays(2);
+    if (!started) {
+        config.useAdafruitIO = true;
+        strcpy(config.ioUsername, "grower");
+        strcpy(config.ioKey, "aio_0123456789abcdef");
+        strcpy(config.relayFeedName, "pump");
+        strcpy(config.ipFeedName, "pump-ip");
+        initDeviceEvents();
+        setupAdafruitIO();
+        started = true;
+    }
+}
+
+// loop() passes step ms apart; each connect attempt is logged with its start time
+static void runRecording(uint32_t duration, uint32_t step = 100) {
+    uint64_t end = hostMicros() + duration * 1000ULL;
+    while (hostMicros() < end) {
+        uint32_t attempts = hostBroker.connectAttempts;
+        uint32_t start = millis();
+        runLoop(step, step);
+        if (hostBroker.connectAttempts != attempts) {
+            attemptTimes.push_back(start);
+        }
+    }
+}
+
+// Connected with the broker up, whatever the previous case left behind
+static void setUp() {
+    startClient();
+    bool sessionOpen = hostBroker.sessionOpen;
+    hostBroker = HostBroker();
+    hostBroker.sessionOpen = sessionOpen;
+    hostBroker.connectMillis = 300; // TLS handshake and CONNACK on a good link
+    WiFi.hostConnect();
+    for (uint32_t waited = 0; !adafruitIOConnected() && waited < IO_BACKOFF_MAX + 1000; waited += 100) {
+        runLoop(100, 100);
+    }
+    hostBroker.connectAttempts = 0;
+    hostBroker.sessions = 0;
+    attemptTimes.clear();
+}
+
+TEST(connectsOnlyOnceWiFiIsUp) {
+    startClient();
+    CHECK_EQ(getAdafruitIOState(), IO_STATE_WAITING);
+
+    runLoop(5000);
+    CHECK_EQ(hostBroker.connectAttempts, 0u);
+    CHECK_EQ(getAdafruitIOState(), IO_STATE_WAITING);
+
+    WiFi.hostConnect();
+    runLoop(100);
+    CHECK(adafruitIOConnected());
+    CHECK_EQ(hostBroker.connectAttempts, 1u);
+    // Feeds are caught up on connect
+    CHECK(io->feeds[0].name == "pump");
+    CHECK_EQ(io->feeds[0].saves, 1u);
+    CHECK(io->feeds[1].lastValue == WiFi.localIP().toString());
+}
+
+TEST(outageBacksOffExponentiallyWithJitter) {
+    setUp();
+    hostBroker.reachable = false;
+    hostBroker.connectMillis = IO_CONNECT_TIMEOUT;
+    runRecording(60UL * 60 * 1000);
+
+    // Losing the session was the first failure, so the wait before attempt n
+    // is between half and all of min(MIN << n, MAX); the gap adds the attempt
+    // itself and up to two passes
+    CHECK(attemptTimes.size() >= 13);
+    for (size_t i = 1; i < attemptTimes.size(); i++) {
+        uint32_t ceiling = min<uint32_t>(IO_BACKOFF_MAX, (uint32_t)IO_BACKOFF_MIN << min<size_t>(i, 15));
+        uint32_t gap = attemptTimes[i] - attemptTimes[i - 1];
+        CHECK(gap >= ceiling / 2 + IO_CONNECT_TIMEOUT);
+        CHECK(gap <= ceiling + IO_CONNECT_TIMEOUT + 200);
+    }
+    CHECK_EQ(getAdafruitIOState(), IO_STATE_BACKOFF);
+}
+
+TEST(reconnectsWhenBrokerReturns) {
+    setUp();
+    hostBroker.reachable = false;
+    runRecording(5UL * 60 * 1000);
+    CHECK(!adafruitIOConnected());
+
+    hostBroker.reachable = true;
+    runRecording(IO_BACKOFF_MAX + 1000);
+    CHECK(adafruitIOConnected());
+    CHECK_EQ(hostBroker.sessions, 1u);
+
+    // A later drop starts again from the shortest delay
+    attemptTimes.clear();
+    uint32_t dropped = millis();
+    hostBroker.dropSession();
+    runRecording(IO_BACKOFF_MIN + 1000);
+    CHECK(adafruitIOConnected());
+    CHECK_EQ(attemptTimes.size(), 1u);
+    CHECK(attemptTimes[0] - dropped <= IO_BACKOFF_MIN + 200);
+}
+
+TEST(pingFindsAStaleSession) {
+    setUp();
+    runRecording(5UL * 60 * 1000);
+    CHECK(hostBroker.pings >= 4 && hostBroker.pings <= 5);
+    CHECK_EQ(hostBroker.connectAttempts, 0u);
+
+    // Broker restarted: the next poll notices, reconnect after one backoff
+    hostBroker.dropSession();
+    runLoop(100);
+    CHECK_EQ(getAdafruitIOState(), IO_STATE_BACKOFF);
+    runRecording(IO_BACKOFF_MIN + 1000);
+    CHECK(adafruitIOConnected());
+    CHECK_EQ(hostBroker.connectAttempts, 1u);
+}
+
+TEST(wifiLossPausesWithoutAttempts) {
+    setUp();
+    WiFi.hostDisconnect();
+    runRecording(10UL * 60 * 1000);
+    CHECK_EQ(getAdafruitIOState(), IO_STATE_WAITING);
+    CHECK_EQ(hostBroker.connectAttempts, 0u);
+
+    hostBroker.dropSession(); // The broker timed the session out meanwhile
+    WiFi.hostConnect();
+    runLoop(100);
+    CHECK(adafruitIOConnected());
+    CHECK_EQ(hostBroker.connectAttempts, 1u);
+}
+
+TEST(feedDrivesTheDeviceAndFollowsIt) {
+    setUp();
+    setDeviceState(false);
+    runLoop(100);
+    AdafruitIO_Feed& feed = io->feeds[0];
+    feed.hostReceive("1");
+    CHECK(deviceState);
+    CHECK_EQ(getRelayMask(), 0x03);
+    runLoop(100);
+
+    uint32_t saves = feed.saves;
+    setDeviceState(false);
+    runLoop(100);
+    CHECK_EQ(feed.saves, saves + 1);
+    CHECK(feed.lastValue == "0");
+}
+
+BENCH(outageCost) {
+    setUp();
+    hostBroker.reachable = false;
+    hostBroker.connectMillis = IO_CONNECT_TIMEOUT;
+    uint64_t start = hostMicros();
+    runRecording(60UL * 60 * 1000);
+    uint64_t elapsed = hostMicros() - start;
+    uint64_t blocked = static_cast<uint64_t>(attemptTimes.size()) * IO_CONNECT_TIMEOUT;
+
+    // Without backoff: an attempt on every pass once the previous one times out
+    uint64_t retryEveryPass = elapsed / 1000 / (IO_CONNECT_TIMEOUT + 10);
+    REPORT("1 h broker outage, %u ms per failed attempt: %u attempts, loop blocked %.1f%% of the time "
+           "(retrying every pass: ~%u attempts, ~99%%)",
+           IO_CONNECT_TIMEOUT, (unsigned)attemptTimes.size(), 100.0 * blocked * 1000 / elapsed,
+           (unsigned)retryEveryPass);
+    CHECK(attemptTimes.size() < 25);
+}
+
+TEST(rejectedCredentialsDisableTheClient) {
+    setUp();
+    hostBroker.acceptCredentials = false;
+    hostBroker.dropSession();
+    runRecording(60UL * 60 * 1000);
+    CHECK_EQ(getAdafruitIOState(), IO_STATE_DISABLED);
+    CHECK_EQ(hostBroker.connectAttempts, 1u);
+    CHECK(hostSerialOutput().find("rejected the credentials") != std::string::npos);
+}
@@ -0,0 +1,194 @@
+// test_adc_filter.cpp
+// Only slot 0 is configured, so every adcSample() reads it
+#include "test.h"
+#include "adc_filter.h"
+#include <cmath>
+#include <vector>
+
+#define ADC_PIN 17
+
+static volatile float benchSink;
+
+static int level;
+static std::vector<int> script;
+static size_t scriptNext;
+
+static int constantLevel(uint8_t pin) {
+    return level;
+}
+
+static int scripted(uint8_t pin) {
+    int value = script[scriptNext % script.size()];
+    scriptNext++;
+    return value;
+}
+
+// A steady reading with the noise a soil probe on a long lead picks up:
+// roughly gaussian jitter of ~9 counts, and a rail-to-rail spike on about
+// one read in 40 when the radio transmits
+static uint32_t noiseState;
+static int lastRaw;
+
+static int noisyLevel(uint8_t pin) {
+    noiseState = noiseState * 1664525u + 1013904223u;
+    int jitter = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        jitter += static_cast<int>((noiseState >> (8 * i)) & 0xFF) - 128;
+    }
+    lastRaw = level + jitter / 16;
+    if ((noiseState >> 3) % 40 == 0) {
+        lastRaw = (noiseState & 0x100) ? 1023 : 0;
+    }
+    return lastRaw;
+}
+
+static float readCounts() {
+    float percent = NAN;
+    CHECK(adcFilterRead(0, percent));
+    return percent * ADC_MAX_READING / 100.0f;
+}
+
+static void samples(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        adcSample();
+    }
+}
+
+TEST(nothingUntilTheFirstBlockIsIn) {
+    level = 512;
+    hostSetAnalogSource(constantLevel);
+    adcFilterBegin(0, ADC_PIN, SENSOR_FILTER(2, 0, 0));
+    float percent = NAN;
+    samples(15);
+    CHECK(!adcFilterRead(0, percent));
+    samples(1);
+    CHECK(adcFilterRead(0, percent));
+    CHECK_NEAR(percent, 512 * 100.0f / ADC_MAX_READING, 0.01f);
+}
+
+TEST(oversamplingResolvesBelowOneCount) {
+    // Dithering between 300 and 301 averages to 300.25 over a block of 4
+    script = {300, 300, 300, 301};
+    scriptNext = 0;
+    hostSetAnalogSource(scripted);
+    adcFilterBegin(0, ADC_PIN, SENSOR_FILTER(1, 0, 0));
+    samples(4);
+    CHECK_NEAR(readCounts(), 300.25f, 0.01f);
+}
+
+TEST(medianDropsASingleSpike) {
+    script = {500, 500, 1023, 500, 500, 0, 500};
+    scriptNext = 0;
+    hostSetAnalogSource(scripted);
+    adcFilterBegin(0, ADC_PIN, SENSOR_FILTER(0, 1, 0));
+    for (size_t i = 0; i < script.size(); i++) {
+        adcSample();
+        if (i >= 1) {
+            CHECK_NEAR(readCounts(), 500.0f, 0.01f);
+        }
+    }
+
+    // Two spikes in a window of five still lose
+    script = {500, 1023, 500, 1023, 500};
+    scriptNext = 0;
+    adcFilterBegin(0, ADC_PIN, SENSOR_FILTER(0, 2, 0));
+    samples(script.size());
+    CHECK_NEAR(readCounts(), 500.0f, 0.01f);
+}
+
+TEST(emaIsPrimedAndFollowsAStep) {
+    level = 200;
+    hostSetAnalogSource(constantLevel);
+    adcFilterBegin(0, ADC_PIN, SENSOR_FILTER(0, 0, 2));
+    adcSample();
+    CHECK_NEAR(readCounts(), 200.0f, 0.01f); // No ramp up from zero
+
+    level = 600;
+    adcSample();
+    CHECK_NEAR(readCounts(), 300.0f, 0.05f); // A quarter of the way
+    samples(40);
+    CHECK_NEAR(readCounts(), 600.0f, 0.05f);
+}
+
+TEST(fullScaleFitsSixteenBits) {
+    level = ADC_MAX_READING;
+    hostSetAnalogSource(constantLevel);
+    adcFilterBegin(0, ADC_PIN, SENSOR_FILTER(3, 2, 7));
+    samples(64 * 10);
+    float percent = NAN;
+    CHECK(adcFilterRead(0, percent));
+    CHECK_NEAR(percent, 100.0f, 0.01f);
+}
+
+struct NoiseResult {
+    double rawDeviation;
+    double deviation;
+    double worstError;
+};
+
+// Standard deviation of the raw reads and of the filter output, sampled
+// once per decimated value, after a warm-up
+static NoiseResult measureNoise(uint8_t filter) {
+    level = 512;
+    noiseState = 1;
+    hostSetAnalogSource(noisyLevel);
+    adcFilterBegin(0, ADC_PIN, filter);
+    uint32_t block = 1u << (2 * SENSOR_FILTER_OVERSAMPLE(filter));
+    samples(block * 50);
+
+    double rawSum = 0, rawSquares = 0, sum = 0, squares = 0, worst = 0;
+    const uint32_t outputs = 2000;
+    for (uint32_t i = 0; i < outputs; i++) {
+        for (uint32_t j = 0; j < block; j++) {
+            adcSample();
+            rawSum += lastRaw;
+            rawSquares += static_cast<double>(lastRaw) * lastRaw;
+        }
+        double value = readCounts();
+        sum += value;
+        squares += value * value;
+        worst = std::max(worst, std::fabs(value - level));
+    }
+    uint32_t raws = outputs * block;
+    NoiseResult result;
+    result.rawDeviation = std::sqrt(rawSquares / raws - (rawSum / raws) * (rawSum / raws));
+    result.deviation = std::sqrt(squares / outputs - (sum / outputs) * (sum / outputs));
+    result.worstError = worst;
+    return result;
+}
+
+TEST(defaultFilterRejectsNoiseAndSpikes) {
+    NoiseResult result = measureNoise(SENSOR_DEFAULT_FILTER);
+    CHECK(result.deviation * 10 < result.rawDeviation);
+    // Spikes are averaged into their block before the median sees them, so
+    // some of each gets through; unfiltered, one moves a reading by 512
+    CHECK(result.worstError < 50);
+}
+
+// Noise left after each stage on the signal above, and the host cost of
+// one adcSample() including the analogRead() stand-in
+BENCH(noiseReductionAndCostPerSample) {
+    static const struct {
+        const char* name;
+        uint8_t filter;
+    } pipelines[] = {
+        {"raw", SENSOR_FILTER(0, 0, 0)},
+        {"16x oversampling", SENSOR_FILTER(2, 0, 0)},
+        {"median of 3", SENSOR_FILTER(0, 1, 0)},
+        {"16x + median 3", SENSOR_FILTER(2, 1, 0)},
+        {"default (16x, median 3, 1/4)", SENSOR_DEFAULT_FILTER},
+        {"64x, median 5, 1/16", SENSOR_FILTER(3, 2, 4)},
+    };
+
+    for (const auto& pipeline : pipelines) {
+        NoiseResult result = measureNoise(pipeline.filter);
+        double cost = nanosPerCall(1000000, [](uint32_t i) { adcSample(); });
+        float percent;
+        adcFilterRead(0, percent);
+        benchSink = percent;
+        REPORT("%-30s std dev %6.2f counts (raw %6.2f), worst %6.1f, %5.1f ns per sample (host)", pipeline.name,
+               result.deviation, result.rawDeviation, result.worstError, cost);
+    }
+    REPORT("one output per %u ms per sensor with the default filter at %u ms per sample",
+           16 * ADC_SAMPLE_INTERVAL, ADC_SAMPLE_INTERVAL);
+}
@@ -0,0 +1,133 @@
+// test_api.cpp
+#include "fixture.h"
+#include "api.h"
+#include "commands.h"
+#include "sensors.h"
+
+static volatile size_t benchSink;
+
+static void setUp() {
+    startWebServer();
+    configureRelays(4);
+    config.sensorCount = 2;
+    config.sensors[0] = SensorConfig{SENSOR_DHT, 4, 22, 0, false, 60, SENSOR_DEFAULT_FILTER};
+    config.sensors[1] = SensorConfig{SENSOR_SOIL, 17, 0, 0, false, 60, SENSOR_DEFAULT_FILTER};
+    sensorData[0].temperature = 22.5f;
+    sensorData[0].humidity = 41.0f;
+    sensorData[1].moisture = 63.2f;
+    setRelayMask(0x0F, 0x00);
+}
+
+static bool contains(const HostHttpResponse& response, const char* text) {
+    return response.body.find(text) != std::string::npos;
+}
+
+TEST(getRelaysListsEveryRelay) {
+    setUp();
+    setRelayMask(0x0F, 0x05);
+    HostHttpResponse response = server.hostRequest(HTTP_GET, "/api/relays");
+    CHECK_EQ(response.code, 200);
+    CHECK(response.contentType == "application/json");
+    CHECK(contains(response, "{\"index\":0,\"pin\":12,\"state\":true}"));
+    CHECK(contains(response, "{\"index\":1,\"pin\":13,\"state\":false}"));
+    CHECK(contains(response, "{\"index\":3,\"pin\":15,\"state\":false}"));
+}
+
+TEST(putRelaysSwitchesTheMaskedRelays) {
+    setUp();
+    setRelayMask(0x0F, 0x08);
+    HostHttpResponse response = server.hostRequest(HTTP_PUT, "/api/relays", "{\"mask\":3,\"states\":1}");
+    CHECK_EQ(response.code, 200);
+    CHECK(contains(response, "\"ok\":true"));
+    CHECK_EQ(getRelayMask(), 0x09);
+}
+
+TEST(singleRelayRoutes) {
+    setUp();
+    HostHttpResponse put = server.hostRequest(HTTP_PUT, "/api/relays/2", "{\"state\":true}");
+    CHECK_EQ(put.code, 200);
+    CHECK_EQ(hostPinLevel(14), LOW);
+
+    HostHttpResponse get = server.hostRequest(HTTP_GET, "/api/relays/2");
+    CHECK_EQ(get.code, 200);
+    CHECK(contains(get, "\"index\":2,\"pin\":14,\"state\":true"));
+}
+
+TEST(badRequestsAreRejected) {
+    setUp();
+    CHECK_EQ(server.hostRequest(HTTP_GET, "/api/relays/4").code, 404);
+    CHECK_EQ(server.hostRequest(HTTP_GET, "/api/relays/x").code, 404);
+    CHECK_EQ(server.hostRequest(HTTP_PUT, "/api/relays/9", "{\"state\":true}").code, 404);
+    CHECK_EQ(server.hostRequest(HTTP_PUT, "/api/relays/1", "{\"on\":true}").code, 400);
+    CHECK_EQ(server.hostRequest(HTTP_PUT, "/api/relays", "not json").code, 400);
+    CHECK_EQ(server.hostRequest(HTTP_GET, "/api/history?sensor=7").code, 404);
+    CHECK_EQ(getRelayMask(), 0x00);
+
+    // Anything else goes to the UI
+    HostHttpResponse unknown = server.hostRequest(HTTP_GET, "/api/nothing");
+    CHECK_EQ(unknown.code, 302);
+    CHECK(unknown.header("Location") == "/");
+}
+
+TEST(retriedCommandIsAppliedOnce) {
+    setUp();
+    uint32_t applied = commandStats.applied;
+    HostHttpResponse first = server.hostRequest(HTTP_PUT, "/api/relays/0", "{\"state\":true,\"id\":901}");
+    setRelayMask(0x01, 0x00); // Someone else switched it off in between
+    HostHttpResponse retry = server.hostRequest(HTTP_PUT, "/api/relays/0", "{\"state\":true,\"id\":901}");
+    CHECK_EQ(retry.code, 200);
+    CHECK(retry.body == first.body);
+    CHECK_EQ(commandStats.applied, applied + 1);
+    CHECK_EQ(getRelayMask(), 0x00);
+}
+
+TEST(collectionsAreServedFromCacheUntilStateChanges) {
+    setUp();
+    HostHttpResponse first = server.hostRequest(HTTP_GET, "/api/relays");
+    uint32_t hits = apiStats.cacheHits;
+    HostHttpResponse second = server.hostRequest(HTTP_GET, "/api/relays");
+    CHECK_EQ(apiStats.cacheHits, hits + 1);
+    CHECK(second.body == first.body);
+
+    setRelayMask(0x02, 0x02);
+    HostHttpResponse third = server.hostRequest(HTTP_GET, "/api/relays");
+    CHECK_EQ(apiStats.cacheHits, hits + 1);
+    CHECK(contains(third, "{\"index\":1,\"pin\":13,\"state\":true}"));
+}
+
+TEST(sensorCacheFollowsSamplingCycles) {
+    setUp();
+    server.hostRequest(HTTP_GET, "/api/sensors");
+    uint32_t hits = apiStats.cacheHits;
+    server.hostRequest(HTTP_GET, "/api/sensors");
+    CHECK_EQ(apiStats.cacheHits, hits + 1);
+
+    // A reading held back by the deadband still shows up here
+    sensorData[1].moisture = 63.3f;
+    sensorSampleVersion++;
+    HostHttpResponse response = server.hostRequest(HTTP_GET, "/api/sensors");
+    CHECK_EQ(apiStats.cacheHits, hits + 1);
+    CHECK(contains(response, "\"moisture\":63.3"));
+}
+
+// Handler cost per request on the host, including the stand-in server's
+// request parsing; the difference between the two is the serialization
+// the cache saves
+BENCH(cachedVersusSerializedResponses) {
+    setUp();
+    const uint32_t iterations = 50000;
+    static const char* paths[] = {"/api/relays", "/api/sensors", "/api/status"};
+
+    for (const char* path : paths) {
+        double hit = nanosPerCall(iterations, [path](uint32_t i) {
+            benchSink = server.hostRequest(HTTP_GET, path).body.size();
+        });
+        double miss = nanosPerCall(iterations, [path](uint32_t i) {
+            stateVersion++; // Any relay or sensor change
+            benchSink = server.hostRequest(HTTP_GET, path).body.size();
+        });
+        size_t bytes = server.hostRequest(HTTP_GET, path).body.size();
+        REPORT("GET %-12s %3u bytes  cached %5.0f ns  serialized %5.0f ns", path, (unsigned)bytes, hit, miss);
+        CHECK(hit < miss);
+    }
+}
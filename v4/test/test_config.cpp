@@ -0,0 +1,249 @@
+// test_config.cpp
+#include "fixture.h"
+
+static uint8_t* eepromSector() {
+    return hostFlash() + HOST_EEPROM_SECTOR * SPI_FLASH_SEC_SIZE;
+}
+
+static ConfigHeader storedHeader() {
+    ConfigHeader header;
+    memcpy(&header, eepromSector() + CONFIG_ADDRESS, sizeof(header));
+    return header;
+}
+
+// Drops any save left pending by the previous test before clearing flash
+static void setUp() {
+    flushPersistence();
+    hostEraseFlash();
+    memset(&config, 0, sizeof(config));
+    legacyConfigMigrated = false;
+}
+
+static void fillConfig() {
+    memset(&config, 0, sizeof(config));
+    strcpy(config.wifiSSID, "greenhouse");
+    strcpy(config.wifiPassword, "correct horse battery staple");
+    strcpy(config.mdnsName, "relay-3");
+    config.useAdafruitIO = true;
+    strcpy(config.ioUsername, "grower");
+    strcpy(config.ioKey, "aio_0123456789abcdef");
+    strcpy(config.relayFeedName, "pump");
+    strcpy(config.ipFeedName, "pump-ip");
+    config.relayCount = 3;
+    config.relayPins[0] = 12;
+    config.relayPins[1] = 13;
+    config.relayPins[2] = 16;
+    config.sensorCount = 2;
+    config.sensors[0] = SensorConfig{SENSOR_DHT, 4, 22, 5, false, 30, 0};
+    config.sensors[1] = SensorConfig{SENSOR_SOIL, 17, 0, 10, true, 120, SENSOR_FILTER(3, 2, 4)};
+}
+
+static void checkSensor(const SensorConfig& actual, const SensorConfig& expected) {
+    CHECK_EQ(actual.type, expected.type);
+    CHECK_EQ(actual.pin, expected.pin);
+    CHECK_EQ(actual.dhtType, expected.dhtType);
+    CHECK_EQ(actual.deadband, expected.deadband);
+    CHECK_EQ(actual.deadbandPercent, expected.deadbandPercent);
+    CHECK_EQ(actual.maxSilence, expected.maxSilence);
+    CHECK_EQ(actual.filter, expected.filter);
+}
+
+// Legacy images are raw struct dumps; v4 also kept one 0/1 byte per relay after it
+static LegacyDeviceConfig legacyImage() {
+    LegacyDeviceConfig legacy;
+    memset(&legacy, 0, sizeof(legacy));
+    strcpy(legacy.wifiSSID, "old-net");
+    strcpy(legacy.wifiPassword, "hunter22");
+    strcpy(legacy.mdnsName, "esp-old");
+    strcpy(legacy.relayFeedName, "relay");
+    strcpy(legacy.ipFeedName, "ip");
+    legacy.configVersion = LEGACY_CONFIG_VERSION;
+    legacy.savedDeviceState = true;
+    legacy.relayCount = 2;
+    legacy.relayPins[0] = 5;
+    legacy.relayPins[1] = 4;
+    return legacy;
+}
+
+static void writeLegacyImage(const LegacyDeviceConfig& legacy, const uint8_t* relayBytes = nullptr) {
+    memcpy(eepromSector() + CONFIG_ADDRESS, &legacy, sizeof(legacy));
+    if (relayBytes) {
+        memcpy(eepromSector() + CONFIG_ADDRESS + sizeof(legacy), relayBytes, legacy.relayCount);
+    }
+}
+
+TEST(crc32MatchesTheStandardCheckValue) {
+    const char* check = "123456789";
+    CHECK_EQ(crc32(reinterpret_cast<const uint8_t*>(check), strlen(check)), 0xCBF43926u);
+    CHECK_EQ(crc32(nullptr, 0), 0u);
+}
+
+TEST(packedConfigRoundTrips) {
+    setUp();
+    fillConfig();
+    DeviceConfig saved = config;
+    commitConfig();
+
+    memset(&config, 0xEE, sizeof(config));
+    loadConfig();
+    CHECK(!legacyConfigMigrated);
+    CHECK(strcmp(config.wifiSSID, saved.wifiSSID) == 0);
+    CHECK(strcmp(config.wifiPassword, saved.wifiPassword) == 0);
+    CHECK(strcmp(config.mdnsName, saved.mdnsName) == 0);
+    CHECK(strcmp(config.ioUsername, saved.ioUsername) == 0);
+    CHECK(strcmp(config.ioKey, saved.ioKey) == 0);
+    CHECK(strcmp(config.relayFeedName, saved.relayFeedName) == 0);
+    CHECK(strcmp(config.ipFeedName, saved.ipFeedName) == 0);
+    CHECK_EQ(config.useAdafruitIO, true);
+    CHECK_EQ(config.relayCount, 3);
+    CHECK(memcmp(config.relayPins, saved.relayPins, 3) == 0);
+    CHECK_EQ(config.sensorCount, 2);
+    checkSensor(config.sensors[0], saved.sensors[0]);
+    checkSensor(config.sensors[1], saved.sensors[1]);
+}
+
+TEST(packedImageIsSmallerThanTheStruct) {
+    setUp();
+    fillConfig();
+    commitConfig();
+    ConfigHeader header = storedHeader();
+    CHECK_EQ(header.magic, CONFIG_MAGIC);
+    CHECK_EQ(header.schemaVersion, CONFIG_SCHEMA_VERSION);
+    REPORT("packed image %u bytes (at most %u), legacy struct %u bytes",
+           (unsigned)(sizeof(ConfigHeader) + header.length), (unsigned)CONFIG_STORE_SIZE,
+           (unsigned)sizeof(LegacyDeviceConfig));
+    CHECK(sizeof(ConfigHeader) + header.length < sizeof(LegacyDeviceConfig) / 2);
+}
+
+TEST(corruptPayloadFallsBackToDefaults) {
+    setUp();
+    fillConfig();
+    commitConfig();
+    eepromSector()[sizeof(ConfigHeader) + 3] ^= 0x01; // A bit in the SSID
+
+    loadConfig();
+    CHECK(hostSerialOutput().find("failed CRC/validation") != std::string::npos);
+    CHECK(strcmp(config.wifiSSID, "") == 0);
+    CHECK(strcmp(config.mdnsName, "esp-device") == 0);
+    CHECK_EQ(config.relayCount, 0);
+}
+
+TEST(olderSchemaIsUpgradedInPlace) {
+    setUp();
+    fillConfig();
+    commitConfig();
+    // Schema 2 had the same entries, but the filter bits were unused
+    eepromSector()[offsetof(ConfigHeader, schemaVersion)] = 2;
+
+    loadConfig();
+    CHECK_EQ(config.sensors[1].filter, SENSOR_DEFAULT_FILTER);
+    CHECK_EQ(config.sensors[1].deadband, 10);
+    flushPersistence();
+    CHECK_EQ(storedHeader().schemaVersion, CONFIG_SCHEMA_VERSION);
+}
+
+TEST(unknownSensorTypeIsLeftOff) {
+    setUp();
+    fillConfig();
+    config.sensors[0].type = static_cast<SensorType>(7); // From a newer firmware
+    commitConfig();
+
+    loadConfig();
+    CHECK_EQ(config.sensorCount, 2);
+    CHECK_EQ(config.sensors[0].type, SENSOR_NONE);
+    CHECK_EQ(config.sensors[1].type, SENSOR_SOIL);
+}
+
+TEST(v4ImageMigrates) {
+    setUp();
+    LegacyDeviceConfig legacy = legacyImage();
+    legacy.sensorCount = 3;
+    legacy.sensors[0] = LegacySensorConfig{SENSOR_DHT, 4, 11};
+    legacy.sensors[1] = LegacySensorConfig{SENSOR_LDR, 17, 0};
+    legacy.sensors[2] = LegacySensorConfig{SENSOR_SOIL, 17, 0};
+    const uint8_t relayBytes[] = {1, 0};
+    writeLegacyImage(legacy, relayBytes);
+
+    loadConfig();
+    CHECK(legacyConfigMigrated);
+    CHECK(strcmp(config.wifiSSID, "old-net") == 0);
+    CHECK(strcmp(config.mdnsName, "esp-old") == 0);
+    CHECK_EQ(config.relayCount, 2);
+    CHECK_EQ(config.relayPins[0], 5);
+    CHECK_EQ(config.sensorCount, 3);
+    CHECK_EQ(config.sensors[0].type, SENSOR_DHT);
+    CHECK_EQ(config.sensors[0].dhtType, 11);
+    CHECK_EQ(config.sensors[1].type, SENSOR_LDR);
+    CHECK_EQ(config.sensors[2].type, SENSOR_SOIL);
+    CHECK_EQ(config.sensors[2].filter, SENSOR_DEFAULT_FILTER);
+
+    // The converted image is written once; the next boot reads it directly
+    flushPersistence();
+    CHECK_EQ(storedHeader().magic, CONFIG_MAGIC);
+    legacyConfigMigrated = false;
+    loadConfig();
+    CHECK(!legacyConfigMigrated);
+    CHECK_EQ(config.sensorCount, 3);
+    // The packed image stops short of the relay bytes the old struct left
+    CHECK_EQ(eepromSector()[sizeof(LegacyDeviceConfig)], 0xFF);
+}
+
+TEST(v3ImageMigratesWithRenumberedTypes) {
+    setUp();
+    // v3: NONE, DHT, SOIL, WATER, LDR, LM35, and no relay state bytes
+    LegacyDeviceConfig legacy = legacyImage();
+    legacy.sensorCount = 4;
+    legacy.sensors[0] = LegacySensorConfig{2, 17, 0}; // Soil
+    legacy.sensors[1] = LegacySensorConfig{3, 5, 0};  // Water, no v4 driver
+    legacy.sensors[2] = LegacySensorConfig{4, 17, 0}; // LDR
+    legacy.sensors[3] = LegacySensorConfig{1, 4, 22}; // DHT
+    writeLegacyImage(legacy);
+
+    loadConfig();
+    CHECK(legacyConfigMigrated);
+    CHECK_EQ(config.sensorCount, 3);
+    CHECK_EQ(config.sensors[0].type, SENSOR_SOIL);
+    CHECK_EQ(config.sensors[1].type, SENSOR_LDR);
+    CHECK_EQ(config.sensors[2].type, SENSOR_DHT);
+    CHECK_EQ(config.sensors[2].dhtType, 22);
+}
+
+TEST(ambiguousImageKeepsOnlyDht) {
+    setUp();
+    // No relay bytes and no v3-only type: 2 is soil in v3 but LDR in v4
+    LegacyDeviceConfig legacy = legacyImage();
+    legacy.relayCount = 0;
+    legacy.sensorCount = 2;
+    legacy.sensors[0] = LegacySensorConfig{2, 17, 0};
+    legacy.sensors[1] = LegacySensorConfig{1, 4, 22};
+    writeLegacyImage(legacy);
+
+    loadConfig();
+    CHECK(legacyConfigMigrated);
+    CHECK_EQ(config.sensorCount, 1);
+    CHECK_EQ(config.sensors[0].type, SENSOR_DHT);
+    CHECK(hostSerialOutput().find("ambiguous type") != std::string::npos);
+}
+
+TEST(legacySsidThatLooksLikeTheMagicStillMigrates) {
+    setUp();
+    // Not valid UTF-8, but nothing stopped the old firmware from storing it
+    LegacyDeviceConfig legacy = legacyImage();
+    const uint16_t magic = CONFIG_MAGIC;
+    memcpy(legacy.wifiSSID, &magic, sizeof(magic));
+    const uint8_t relayBytes[] = {0, 1};
+    writeLegacyImage(legacy, relayBytes);
+
+    loadConfig();
+    CHECK(legacyConfigMigrated);
+    CHECK(memcmp(config.wifiSSID, &magic, sizeof(magic)) == 0);
+    CHECK_EQ(config.relayCount, 2);
+}
+
+TEST(blankFlashLoadsDefaults) {
+    setUp();
+    loadConfig();
+    CHECK(!legacyConfigMigrated);
+    CHECK(strcmp(config.mdnsName, "esp-device") == 0);
+    CHECK(hostSerialOutput().find("failed CRC") == std::string::npos);
+}
@@ -0,0 +1,153 @@
+// test_deadband.cpp
+#include "fixture.h"
+#include "sensors.h"
+
+#define DHT_SENSOR 0
+#define LDR_SENSOR 1
+#define SOIL_SENSOR 2
+
+static std::shared_ptr<HostSocket> client;
+
+static void setUp(uint8_t dhtDeadband, uint8_t ldrPercent, uint8_t soilDeadband) {
+    startWebServer();
+    client = webSocket.hostConnect(0);
+    config.relayCount = 0;
+    config.sensorCount = 3;
+    config.sensors[DHT_SENSOR] = SensorConfig{SENSOR_DHT, 4, 22, dhtDeadband, false, 60, SENSOR_DEFAULT_FILTER};
+    config.sensors[LDR_SENSOR] = SensorConfig{SENSOR_LDR, 17, 0, ldrPercent, true, 60, SENSOR_DEFAULT_FILTER};
+    config.sensors[SOIL_SENSOR] = SensorConfig{SENSOR_SOIL, 17, 0, soilDeadband, false, 60, SENSOR_DEFAULT_FILTER};
+    memset(sensorData, 0, sizeof(sensorData));
+    sensorStats = SensorStats();
+}
+
+static void setReadings(float temperature, float humidity, float light, float moisture) {
+    sensorData[DHT_SENSOR].temperature = temperature;
+    sensorData[DHT_SENSOR].humidity = humidity;
+    sensorData[LDR_SENSOR].light = light;
+    sensorData[SOIL_SENSOR].moisture = moisture;
+}
+
+// One sampling cycle with the client keeping up
+static void cycle(bool batched) {
+    hostAdvanceMillis(SENSOR_UPDATE_INTERVAL);
+    if (batched) {
+        broadcastSensorFrame();
+    } else {
+        for (int i = 0; i < config.sensorCount; i++) {
+            broadcastSensorData(i);
+        }
+    }
+    client->drain();
+}
+
+TEST(smallChangesAreHeldBack) {
+    setUp(5, 10, 10);
+    setReadings(21.0f, 50.0f, 40.0f, 30.0f);
+    cycle(false);
+    CHECK_EQ(sensorStats.framesSent, 3u); // First readings always go out
+
+    setReadings(21.4f, 50.4f, 43.9f, 30.9f);
+    cycle(false);
+    CHECK_EQ(sensorStats.framesSent, 3u);
+    CHECK_EQ(sensorStats.valuesSuppressed, 3u);
+
+    // Measured from the last published value, so a slow drift still gets out
+    setReadings(21.6f, 50.4f, 44.1f, 31.1f);
+    cycle(false);
+    CHECK_EQ(sensorStats.framesSent, 6u);
+}
+
+TEST(percentDeadbandScalesWithTheValue) {
+    setUp(0, 10, 0);
+    setReadings(20.0f, 50.0f, 200.0f, 30.0f);
+    cycle(false);
+    uint32_t sent = sensorStats.framesSent;
+
+    sensorData[LDR_SENSOR].light = 215.0f; // 7.5%
+    hostAdvanceMillis(SENSOR_UPDATE_INTERVAL);
+    broadcastSensorData(LDR_SENSOR);
+    CHECK_EQ(sensorStats.framesSent, sent);
+
+    sensorData[LDR_SENSOR].light = 225.0f; // 12.5%
+    broadcastSensorData(LDR_SENSOR);
+    CHECK_EQ(sensorStats.framesSent, sent + 1);
+}
+
+TEST(unchangedValueIsRepublishedAfterMaxSilence) {
+    setUp(5, 10, 10);
+    setReadings(21.0f, 50.0f, 40.0f, 30.0f);
+    cycle(true);
+    CHECK_EQ(sensorStats.framesSent, 1u);
+
+    uint32_t cycles = 60000 / SENSOR_UPDATE_INTERVAL;
+    for (uint32_t i = 1; i < cycles; i++) {
+        cycle(true);
+    }
+    CHECK_EQ(sensorStats.framesSent, 1u);
+    cycle(true);
+    CHECK_EQ(sensorStats.framesSent, 2u);
+}
+
+TEST(frameOnlyCarriesSensorsThatMoved) {
+    setUp(5, 10, 10);
+    setReadings(21.0f, 50.0f, 40.0f, 30.0f);
+    cycle(true);
+    webSocket.hostSent[0].clear();
+
+    setReadings(21.0f, 50.0f, 40.0f, 32.0f);
+    cycle(true);
+    CHECK_EQ(webSocket.hostSent[0].size(), 1u);
+    const std::string& json = webSocket.hostSent[0].back().payload;
+    CHECK(json.find("\"moisture\"") != std::string::npos);
+    CHECK(json.find("\"temperature\"") == std::string::npos);
+    CHECK(json.find("\"light\"") == std::string::npos);
+}
+
+// A day of readings with the noise the real parts show at rest: DHT22
+// temperature dithering by its 0.1 C step and humidity by a few tenths, an
+// LDR with a percent of ADC noise and clouds passing, and soil moisture
+// drying slowly between two waterings
+static float noise(float amplitude) {
+    return amplitude * (random(2001) - 1000) / 1000.0f;
+}
+
+static void replayDay(bool batched) {
+    const uint32_t cycles = 24UL * 3600 * 1000 / SENSOR_UPDATE_INTERVAL;
+    randomSeed(8);
+    for (uint32_t i = 0; i < cycles; i++) {
+        float hours = i * (SENSOR_UPDATE_INTERVAL / 3600000.0f);
+        float daylight = max(0.0f, sinf((hours - 6) * static_cast<float>(M_PI) / 12));
+        float temperature = roundf((18 + 6 * daylight + noise(0.1f)) * 10) / 10;
+        float humidity = roundf((60 - 15 * daylight + noise(0.3f)) * 10) / 10;
+        float light = 2 + 90 * daylight * (random(100) < 3 ? 0.6f : 1.0f) + noise(1.0f);
+        float moisture = 70 - 2.5f * fmodf(hours, 12) + noise(0.4f);
+        setReadings(temperature, humidity, light, moisture);
+        cycle(batched);
+    }
+}
+
+BENCH(deadbandTraceReplay) {
+    struct Run {
+        const char* name;
+        bool batched;
+        uint32_t frames[2];
+        uint32_t bytes[2];
+    } runs[] = {{"one message per sensor", false, {}, {}}, {"batched frame", true, {}, {}}};
+
+    for (Run& run : runs) {
+        for (int deadband = 0; deadband < 2; deadband++) {
+            // 0.3 C / 0.3 %RH, 5 % of the light level, 1.0 % moisture
+            setUp(deadband ? 3 : 0, deadband ? 5 : 0, deadband ? 10 : 0);
+            replayDay(run.batched);
+            run.frames[deadband] = sensorStats.framesSent;
+            run.bytes[deadband] = sensorStats.bytesSent;
+        }
+        REPORT("24 h at %u s, %-22s no deadband %5u msgs %7u bytes, deadband %5u msgs %6u bytes (%.0f%% fewer bytes)",
+               SENSOR_UPDATE_INTERVAL / 1000, run.name, run.frames[0], run.bytes[0], run.frames[1], run.bytes[1],
+               100.0 * (run.bytes[0] - run.bytes[1]) / run.bytes[0]);
+        // A batched frame goes out if any one sensor moved, so there the
+        // saving is mostly in the entries left out of it
+        CHECK(run.frames[1] < run.frames[0]);
+        CHECK(run.bytes[1] * 2 < run.bytes[0]);
+    }
+}
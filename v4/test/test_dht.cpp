@@ -0,0 +1,217 @@
+// test_dht.cpp
+#include "test.h"
+#include "dht_async.h"
+
+#define DHT_PIN 4
+
+struct DhtResult {
+    uint32_t calls;
+    uint8_t slot;
+    bool ok;
+    float temperature;
+    float humidity;
+};
+
+static DhtResult result;
+
+static void recordResult(uint8_t slot, bool ok, float temperature, float humidity) {
+    result.calls++;
+    result.slot = slot;
+    result.ok = ok;
+    result.temperature = temperature;
+    result.humidity = humidity;
+}
+
+static void setUp(uint8_t type) {
+    result = DhtResult{0, 0, false, NAN, NAN};
+    dhtOnResult(recordResult);
+    dhtBegin(0, DHT_PIN, type);
+}
+
+// Start pulse held, then released by the Ticker with the edge interrupt attached
+static void startRead(uint8_t type) {
+    CHECK(dhtStartRead(0));
+    CHECK_EQ(hostPinMode(DHT_PIN), OUTPUT);
+    CHECK_EQ(hostPinLevel(DHT_PIN), LOW);
+    hostAdvanceMillis(type == 11 ? DHT11_START_MS : DHT22_START_MS);
+    CHECK_EQ(hostPinMode(DHT_PIN), INPUT_PULLUP);
+    CHECK(hostInterruptAttached(DHT_PIN));
+}
+
+// The sensor's answer as falling edges: the response edge ~80 us after the
+// release, the edge that opens bit 0 ~160 us later, then one edge per bit,
+// 77 us after the previous for a 0 and 120 us for a 1. Edges past `edges`
+// never come; a missed response edge falls before the interrupt sees it.
+static void sendResponse(const uint8_t data[5], uint8_t edges = DHT_EDGE_COUNT, bool missResponseEdge = false) {
+    hostAdvanceMicros(80);
+    if (!missResponseEdge) {
+        hostFireInterrupt(DHT_PIN);
+    }
+    hostAdvanceMicros(160);
+    hostFireInterrupt(DHT_PIN);
+    for (uint8_t bit = 0; bit < 40 && bit + 2 < edges; bit++) {
+        hostAdvanceMicros(data[bit / 8] & (0x80 >> (bit % 8)) ? 120 : 77);
+        hostFireInterrupt(DHT_PIN);
+    }
+}
+
+static void withChecksum(uint8_t data[5]) {
+    data[4] = static_cast<uint8_t>(data[0] + data[1] + data[2] + data[3]);
+}
+
+TEST(dht22ReadingArrivesThroughThePoll) {
+    setUp(22);
+    uint8_t data[5] = {0x02, 0x8C, 0x01, 0x5F, 0}; // 65.2 %RH, 35.1 C
+    withChecksum(data);
+    startRead(22);
+    sendResponse(data);
+    CHECK_EQ(result.calls, 0u); // Decoding waits for the scheduler
+
+    dhtPoll();
+    CHECK_EQ(result.calls, 1u);
+    CHECK(result.ok);
+    CHECK_NEAR(result.humidity, 65.2f, 0.01f);
+    CHECK_NEAR(result.temperature, 35.1f, 0.01f);
+    CHECK(!hostInterruptAttached(DHT_PIN));
+
+    // Idle again: the next read starts
+    CHECK(dhtStartRead(0));
+}
+
+TEST(dht22NegativeTemperature) {
+    setUp(22);
+    uint8_t data[5] = {0x01, 0x90, 0x80, 0x65, 0}; // 40.0 %RH, -10.1 C
+    withChecksum(data);
+    startRead(22);
+    sendResponse(data);
+    dhtPoll();
+    CHECK(result.ok);
+    CHECK_NEAR(result.humidity, 40.0f, 0.01f);
+    CHECK_NEAR(result.temperature, -10.1f, 0.01f);
+}
+
+TEST(dht11UsesTheLongStartPulse) {
+    setUp(11);
+    uint8_t data[5] = {45, 0, 3, 0x82, 0}; // 45 %RH, -3.2 C
+    withChecksum(data);
+    CHECK(dhtStartRead(0));
+    hostAdvanceMillis(DHT22_START_MS);
+    CHECK_EQ(hostPinMode(DHT_PIN), OUTPUT); // Still holding the line
+    hostAdvanceMillis(DHT11_START_MS - DHT22_START_MS);
+    CHECK(hostInterruptAttached(DHT_PIN));
+
+    sendResponse(data);
+    dhtPoll();
+    CHECK(result.ok);
+    CHECK_NEAR(result.humidity, 45.0f, 0.01f);
+    CHECK_NEAR(result.temperature, -3.2f, 0.01f);
+}
+
+TEST(missedResponseEdgeStillDecodes) {
+    setUp(22);
+    uint8_t data[5] = {0x01, 0xF4, 0x00, 0xC8, 0}; // 50.0 %RH, 20.0 C
+    withChecksum(data);
+    startRead(22);
+    sendResponse(data, DHT_EDGE_COUNT, true);
+
+    // One edge short: the driver waits out the capture, then decodes the
+    // last 41 edges
+    dhtPoll();
+    CHECK_EQ(result.calls, 0u);
+    hostAdvanceMicros(DHT_CAPTURE_TIMEOUT_US);
+    dhtPoll();
+    CHECK(result.ok);
+    CHECK_NEAR(result.humidity, 50.0f, 0.01f);
+    CHECK_NEAR(result.temperature, 20.0f, 0.01f);
+}
+
+TEST(decodeNeedsFortyOneEdges) {
+    uint32_t edges[DHT_EDGE_COUNT] = {0};
+    float temperature = NAN;
+    float humidity = NAN;
+    CHECK(!dhtDecode(edges, DHT_EDGE_COUNT - 2, 22, temperature, humidity));
+    CHECK(std::isnan(temperature) && std::isnan(humidity));
+
+    // 41 edges 77 us apart: forty 0 bits, and a zero checksum matches
+    for (uint8_t i = 0; i < DHT_EDGE_COUNT - 1; i++) {
+        edges[i] = 1000 + i * 77;
+    }
+    CHECK(dhtDecode(edges, DHT_EDGE_COUNT - 1, 22, temperature, humidity));
+    CHECK_EQ(temperature, 0.0f);
+    CHECK_EQ(humidity, 0.0f);
+}
+
+TEST(checksumMismatchIsReportedAsFailure) {
+    setUp(22);
+    uint8_t data[5] = {0x02, 0x8C, 0x01, 0x5F, 0};
+    withChecksum(data);
+    data[3] ^= 0x04; // A bit misread on a noisy line
+    startRead(22);
+    sendResponse(data);
+    dhtPoll();
+    CHECK_EQ(result.calls, 1u);
+    CHECK(!result.ok);
+    CHECK(std::isnan(result.temperature) && std::isnan(result.humidity));
+}
+
+TEST(silentSensorTimesOut) {
+    setUp(22);
+    uint8_t data[5] = {0x02, 0x8C, 0x01, 0x5F, 0};
+    withChecksum(data);
+    startRead(22);
+    sendResponse(data, 20); // Unplugged halfway through
+
+    hostAdvanceMicros(DHT_CAPTURE_TIMEOUT_US / 2);
+    dhtPoll();
+    CHECK_EQ(result.calls, 0u);
+
+    hostAdvanceMicros(DHT_CAPTURE_TIMEOUT_US);
+    dhtPoll();
+    CHECK_EQ(result.calls, 1u);
+    CHECK(!result.ok);
+    CHECK(!hostInterruptAttached(DHT_PIN));
+    CHECK(dhtStartRead(0));
+}
+
+TEST(secondReadIsRefusedWhileOneIsInFlight) {
+    setUp(22);
+    CHECK(dhtStartRead(0));
+    CHECK(!dhtStartRead(0));
+    CHECK(!dhtStartRead(MAX_SENSORS));
+    hostAdvanceMillis(DHT22_START_MS);
+    hostAdvanceMicros(DHT_CAPTURE_TIMEOUT_US);
+    dhtPoll();
+    CHECK_EQ(result.calls, 1u);
+}
+
+// Time loop() spends in the driver per reading, on the simulated clock,
+// against a blocking read that holds the start pulse and then times every
+// bit with interrupts off
+BENCH(loopTimePerReading) {
+    for (uint8_t type : {11, 22}) {
+        setUp(type);
+        uint8_t data[5] = {0x02, 0x8C, 0x01, 0x5F, 0};
+        withChecksum(data);
+
+        uint64_t inLoop = 0;
+        uint64_t start = hostMicros();
+        CHECK(dhtStartRead(0));
+        inLoop += hostMicros() - start;
+        uint64_t pulse = (type == 11 ? DHT11_START_MS : DHT22_START_MS) * 1000ULL;
+        hostAdvanceMicros(pulse);
+        uint64_t released = hostMicros();
+        sendResponse(data);
+        uint64_t response = hostMicros() - released;
+
+        while (result.calls == 0) {
+            hostAdvanceMillis(DHT_POLL_INTERVAL);
+            uint64_t before = hostMicros();
+            dhtPoll();
+            inLoop += hostMicros() - before;
+        }
+        CHECK(result.ok);
+        REPORT("DHT%u: %llu us of loop() per reading, blocking read %.1f ms with interrupts off for %.1f ms",
+               type, (unsigned long long)inLoop, (pulse + response) / 1000.0, response / 1000.0);
+        CHECK_EQ(inLoop, 0u);
+    }
+}
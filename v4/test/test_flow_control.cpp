@@ -0,0 +1,189 @@
+// test_flow_control.cpp
+#include "fixture.h"
+#include "json_writer.h"
+
+#define FAST_CLIENT 0
+#define SLOW_CLIENT 1
+#define DEBUG_CLIENT 2
+
+static std::shared_ptr<HostSocket> sockets[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+static void setUp() {
+    static bool subscribed = false;
+    if (!subscribed) {
+        initDeviceEvents();
+        subscribed = true;
+    }
+    startWebServer();
+    configureRelays(4);
+    config.sensorCount = 0;
+    wsStats = WsStats();
+    for (uint8_t num = 0; num < 3; num++) {
+        sockets[num] = webSocket.hostConnect(num);
+        sockets[num]->drain();
+        webSocket.hostSent[num].clear();
+    }
+}
+
+static void toggleRelay(uint8_t index) {
+    setRelayMask(1 << index, getRelayMask() ^ (1 << index));
+}
+
+TEST(fullSocketIsSkippedWithoutBlocking) {
+    setUp();
+    sockets[SLOW_CLIENT]->writable = 8;
+
+    uint64_t start = hostMicros();
+    toggleRelay(0);
+    dispatchEvents();
+    CHECK_EQ(hostMicros(), start);
+
+    CHECK_EQ(webSocket.hostSent[FAST_CLIENT].size(), 1u);
+    CHECK_EQ(webSocket.hostSent[SLOW_CLIENT].size(), 0u);
+    CHECK_EQ(sockets[SLOW_CLIENT]->stalls, 0u);
+    CHECK_EQ(wsStats.framesDropped, 1u);
+    CHECK(wsClientFlow[SLOW_CLIENT].snapshotPending);
+}
+
+TEST(oneSnapshotReplacesEverythingMissed) {
+    setUp();
+    sockets[SLOW_CLIENT]->writable = 8;
+    for (uint8_t i = 0; i < 10; i++) {
+        toggleRelay(i % 4);
+        dispatchEvents();
+    }
+    CHECK_EQ(wsStats.framesDropped, 10u);
+
+    // Nothing more goes out until the pending snapshot has
+    sockets[SLOW_CLIENT]->drain();
+    toggleRelay(1);
+    dispatchEvents();
+    CHECK_EQ(webSocket.hostSent[SLOW_CLIENT].size(), 0u);
+
+    wsServiceClients();
+    CHECK_EQ(webSocket.hostSent[SLOW_CLIENT].size(), 1u);
+    const std::string& snapshot = webSocket.hostSent[SLOW_CLIENT][0].payload;
+    CHECK(snapshot.find("\"type\":\"snapshot\"") != std::string::npos);
+    char relays[64];
+    uint8_t relayMask = getRelayMask();
+    snprintf(relays, sizeof(relays), "\"relays\":[%s,%s,%s,%s]", relayMask & 1 ? "true" : "false",
+             relayMask & 2 ? "true" : "false", relayMask & 4 ? "true" : "false", relayMask & 8 ? "true" : "false");
+    CHECK(snapshot.find(relays) != std::string::npos);
+    CHECK(!wsClientFlow[SLOW_CLIENT].snapshotPending);
+
+    toggleRelay(2);
+    dispatchEvents();
+    CHECK_EQ(webSocket.hostSent[SLOW_CLIENT].size(), 2u);
+}
+
+TEST(debugReportsAreDroppedWithoutASnapshot) {
+    setUp();
+    wsSubscribe(DEBUG_CLIENT, 0, 0, false, true);
+    sockets[DEBUG_CLIENT]->writable = 8;
+    const char* report = "{\"type\":\"debug\",\"heap\":30000}";
+    wsBroadcast(WS_TOPIC_DEBUG, report, strlen(report), nullptr, 0);
+    CHECK_EQ(wsStats.framesDropped, 1u);
+    CHECK(!wsClientFlow[DEBUG_CLIENT].snapshotPending);
+}
+
+TEST(stalledClientIsEvicted) {
+    setUp();
+    sockets[SLOW_CLIENT]->writable = 8;
+    uint32_t writes = sockets[SLOW_CLIENT]->writes;
+    toggleRelay(0);
+    dispatchEvents();
+
+    runLoop(WS_STALL_TIMEOUT - 100);
+    CHECK(webSocket.clientIsConnected(SLOW_CLIENT));
+    runLoop(200);
+    CHECK(!webSocket.clientIsConnected(SLOW_CLIENT));
+    CHECK(sockets[SLOW_CLIENT]->aborted);
+    CHECK_EQ(wsStats.clientsEvicted, 1u);
+    // Reset, not closed: a close frame would have stalled on the full buffer
+    CHECK_EQ(sockets[SLOW_CLIENT]->writes, writes);
+    CHECK_EQ(sockets[SLOW_CLIENT]->stalls, 0u);
+    CHECK(webSocket.clientIsConnected(FAST_CLIENT));
+}
+
+// The broadcast before flow control: every client written in turn, each
+// write waiting for buffer space
+static void blockingBroadcast(const char* json, size_t length) {
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        if (webSocket.clientIsConnected(num)) {
+            webSocket.sendTXT(num, json, length);
+        }
+    }
+}
+
+struct LoadResult {
+    uint64_t maxPassMicros;
+    uint64_t stalledMicros;
+    uint32_t fastMessages;
+    uint32_t evictions;
+};
+
+// A minute of relay changes every 250 ms to three clients, one of them on
+// a link that drains 100 bytes/s. Loop passes are 10 ms apart; the pass
+// time is how long loop() itself took on the simulated clock, and changes
+// due while a pass was stalled are made late, as one.
+static LoadResult runSlowClientLoad(bool flowControl) {
+    setUp();
+    hostKeepOutput = false;
+    LoadResult result = {0, 0, 0, 0};
+    const uint32_t step = 10;
+    const uint64_t end = hostMicros() + 60000000ULL;
+    uint64_t nextChange = hostMicros();
+    uint32_t changes = 0;
+    uint32_t fastWrites = sockets[FAST_CLIENT]->writes;
+
+    while (hostMicros() < end) {
+        uint64_t start = hostMicros();
+        if (start >= nextChange) {
+            if (flowControl) {
+                toggleRelay(changes % 4);
+            } else {
+                JsonWriter json(messageBuffer, sizeof(messageBuffer));
+                json.beginObject().add("type", "relay").add("index", 0).add("state", true)
+                    .add("version", static_cast<unsigned long>(changes)).endObject();
+                blockingBroadcast(json.c_str(), json.length());
+            }
+            changes++;
+            while (nextChange <= start) {
+                nextChange += 250000;
+            }
+        }
+        dispatchEvents();
+        wsServiceClients();
+        webSocket.loop();
+        uint64_t pass = hostMicros() - start;
+        result.maxPassMicros = max(result.maxPassMicros, pass);
+        result.stalledMicros += pass;
+
+        // The peers read while the loop was busy too
+        uint64_t elapsedMs = pass / 1000 + step;
+        sockets[FAST_CLIENT]->drain();
+        sockets[DEBUG_CLIENT]->drain();
+        sockets[SLOW_CLIENT]->writable =
+            min<size_t>(sockets[SLOW_CLIENT]->writable + 100 * elapsedMs / 1000, HOST_TCP_SND_BUF);
+        hostAdvanceMillis(step);
+    }
+    result.fastMessages = (sockets[FAST_CLIENT]->writes - fastWrites) / 2; // Header and payload
+    result.evictions = wsStats.clientsEvicted;
+    return result;
+}
+
+BENCH(slowClientLoopLatency) {
+    LoadResult blocking = runSlowClientLoad(false);
+    LoadResult flowControl = runSlowClientLoad(true);
+
+    REPORT("60 s, 4 changes/s, one client draining 100 B/s");
+    REPORT("blocking writes: worst loop pass %6.0f ms, %5.1f s stalled, %3u messages to a fast client",
+           blocking.maxPassMicros / 1000.0, blocking.stalledMicros / 1e6, blocking.fastMessages);
+    REPORT("flow control:    worst loop pass %6.0f ms, %5.1f s stalled, %3u messages to a fast client, %u evicted",
+           flowControl.maxPassMicros / 1000.0, flowControl.stalledMicros / 1e6, flowControl.fastMessages,
+           flowControl.evictions);
+
+    CHECK(blocking.maxPassMicros >= HOST_WRITE_TIMEOUT * 1000ULL);
+    CHECK_EQ(flowControl.maxPassMicros, 0u);
+    CHECK(flowControl.fastMessages > blocking.fastMessages);
+}
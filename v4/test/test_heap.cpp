@@ -0,0 +1,127 @@
+// test_heap.cpp
+#include "fixture.h"
+#include "sensors.h"
+#include "snapshot.h"
+#include "adc_filter.h"
+#include "commands.h"
+
+#define JSON_CLIENT 0
+#define BINARY_CLIENT 1
+
+static std::shared_ptr<HostSocket> sockets[2];
+
+static int analogLevel(uint8_t pin) {
+    static uint32_t step = 0;
+    step++;
+    return 400 + (step * 37) % 64;
+}
+
+static void setUp() {
+    static bool subscribed = false;
+    if (!subscribed) {
+        initDeviceEvents();
+        initSensorEvents();
+        subscribed = true;
+    }
+    startWebServer();
+    configureRelays(4);
+    config.sensorCount = 2;
+    config.sensors[0] = SensorConfig{SENSOR_LDR, 17, 0, 0, false, 60, SENSOR_DEFAULT_FILTER};
+    config.sensors[1] = SensorConfig{SENSOR_SOIL, 17, 0, 0, false, 60, SENSOR_DEFAULT_FILTER};
+    hostSetAnalogSource(analogLevel);
+    sockets[JSON_CLIENT] = webSocket.hostConnect(JSON_CLIENT);
+    sockets[BINARY_CLIENT] = webSocket.hostConnect(BINARY_CLIENT, WS_BINARY_PROTOCOL);
+    hostKeepOutput = false;
+}
+
+TEST(outboundMessagesDoNotAllocate) {
+    setUp();
+    memset(sensorData, 0, sizeof(sensorData));
+    uint32_t allocations = hostHeapStats.allocations;
+
+    for (uint8_t i = 0; i < 50; i++) {
+        setRelayMask(0x0F, i);
+        setDeviceState(i & 1);
+        dispatchEvents();
+        sensorData[0].light = i;
+        sensorData[1].moisture = 100 - i;
+        broadcastSensorFrame();
+        broadcastSensorData(0);
+        sendSnapshot(JSON_CLIENT);
+        sendSnapshot(BINARY_CLIENT);
+        sockets[JSON_CLIENT]->drain();
+        sockets[BINARY_CLIENT]->drain();
+    }
+    CHECK_EQ(hostHeapStats.allocations, allocations);
+}
+
+TEST(commandsDoNotAllocate) {
+    setUp();
+    // Warm up: the first command of a session may set up library state
+    webSocket.hostReceiveText(JSON_CLIENT, "{\"type\":\"relay\",\"index\":0,\"state\":true}");
+    dispatchEvents();
+    uint32_t allocations = hostHeapStats.allocations;
+
+    for (uint16_t seq = 1; seq <= 50; seq++) {
+        const uint8_t frame[] = {WS_OP_RELAY_SET, static_cast<uint8_t>(seq), 0, 1, static_cast<uint8_t>(seq & 1)};
+        webSocket.hostReceive(BINARY_CLIENT, true, frame, sizeof(frame));
+        webSocket.hostReceiveText(JSON_CLIENT, seq & 1 ? "{\"type\":\"relays\",\"mask\":12,\"states\":4}"
+                                                       : "{\"type\":\"relays\",\"mask\":12,\"states\":8}");
+        dispatchEvents();
+        sockets[JSON_CLIENT]->drain();
+        sockets[BINARY_CLIENT]->drain();
+    }
+    CHECK_EQ(hostHeapStats.allocations, allocations);
+}
+
+// A minute of a busy dashboard: sensor cycles, two relay commands, both
+// clients keeping up, and every tenth minute a few REST calls
+static void busyMinute(uint32_t minute) {
+    for (uint32_t second = 0; second < 60; second += 10) {
+        runLoop(10000, 50);
+        sockets[JSON_CLIENT]->drain();
+        sockets[BINARY_CLIENT]->drain();
+    }
+    const uint8_t frame[] = {WS_OP_RELAY_SET, static_cast<uint8_t>(minute), static_cast<uint8_t>(minute >> 8), 1,
+                             static_cast<uint8_t>(minute & 1)};
+    webSocket.hostReceive(BINARY_CLIENT, true, frame, sizeof(frame));
+    webSocket.hostReceiveText(JSON_CLIENT, minute & 1 ? "{\"type\":\"relay\",\"index\":0,\"state\":true}"
+                                                      : "{\"type\":\"relay\",\"index\":0,\"state\":false}");
+    if (minute % 10 == 0) {
+        server.hostRequest(HTTP_GET, "/api/relays");
+        server.hostRequest(HTTP_GET, "/api/sensors");
+        server.hostRequest(HTTP_PUT, "/api/relays/2", minute & 1 ? "{\"state\":true}" : "{\"state\":false}");
+    }
+}
+
+BENCH(dayOfTraffic) {
+    setUp();
+    initializeSensors();
+    scheduleEvery("sensors", SENSOR_UPDATE_INTERVAL, readSensors, SENSOR_UPDATE_INTERVAL);
+
+    // The first hour settles anything allocated once (history, the
+    // library's request state); after that the heap must stay flat
+    for (uint32_t minute = 0; minute < 60; minute++) {
+        busyMinute(minute);
+    }
+    size_t baseline = hostHeapStats.liveBytes;
+    uint32_t allocations = hostHeapStats.allocations;
+    hostHeapStats.peakBytes = baseline;
+
+    for (uint32_t minute = 60; minute < 24 * 60; minute++) {
+        busyMinute(minute);
+    }
+    uint32_t perHour = (hostHeapStats.allocations - allocations) / 23;
+
+    REPORT("23 h after warm-up: live heap %u -> %u bytes, peak %u, %u allocations/h, all from REST requests",
+           (unsigned)baseline, (unsigned)hostHeapStats.liveBytes, (unsigned)hostHeapStats.peakBytes, perHour);
+    REPORT("free heap %u now, %u at the lowest, of %u (the host has no fragmentation model, so max block = free)",
+           ESP.getFreeHeap(), (unsigned)(HOST_HEAP_SIZE - hostHeapStats.peakBytes), HOST_HEAP_SIZE);
+    REPORT("%u sensor cycles, %u sensor frames, %u relay commands", sensorSampleVersion, sensorStats.framesSent,
+           commandStats.applied);
+
+    CHECK(hostHeapStats.liveBytes <= baseline);
+    CHECK(hostHeapStats.peakBytes <= baseline + 4096);
+    CHECK(sensorSampleVersion >= 23 * 720);
+    CHECK(sensorStats.framesSent > 0);
+}
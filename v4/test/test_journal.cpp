@@ -0,0 +1,176 @@
+// test_journal.cpp
+#include "test.h"
+#include "journal.h"
+#include "config.h"
+
+#define RECORDS_PER_SECTOR (SPI_FLASH_SEC_SIZE / sizeof(JournalRecord))
+#define JOURNAL_FIRST_SECTOR (HOST_EEPROM_SECTOR - JOURNAL_SECTOR_COUNT)
+
+static JournalRecord* journalSlot(uint8_t sector, uint16_t slot) {
+    uint8_t* base = hostFlash() + (JOURNAL_FIRST_SECTOR + sector) * SPI_FLASH_SEC_SIZE;
+    return reinterpret_cast<JournalRecord*>(base) + slot;
+}
+
+// A reboot: RAM state is gone, the journal is rescanned from flash
+static bool rebootAndRead(uint8_t& relayMask) {
+    initJournal();
+    return journalRead(relayMask);
+}
+
+TEST(emptyFlashHasNoState) {
+    uint8_t relayMask = 0xAA;
+    CHECK(!rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0xAA);
+}
+
+TEST(appendSurvivesReboot) {
+    initJournal();
+    CHECK(journalAppend(0x05));
+    CHECK(journalAppend(0x03));
+
+    uint8_t relayMask = 0;
+    CHECK(rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0x03);
+    CHECK_EQ(journalSlot(0, 0)->seq, 1u);
+    CHECK_EQ(journalSlot(0, 1)->seq, 2u);
+}
+
+TEST(unchangedStateIsNotWritten) {
+    initJournal();
+    journalAppend(0x01);
+    uint32_t writes = hostFlashStats.writes;
+    uint32_t skipped = journalStats.skipped;
+    CHECK(journalAppend(0x01));
+    CHECK_EQ(hostFlashStats.writes, writes);
+    CHECK_EQ(journalStats.skipped, skipped + 1);
+}
+
+TEST(recordCrcCoversMaskAndSequence) {
+    initJournal();
+    journalAppend(0x01);
+    journalAppend(0x02);
+
+    // A bit that failed to program in the newest record: it no longer
+    // matches its CRC, so the previous record wins
+    journalSlot(0, 1)->relayMask &= ~0x02;
+    uint8_t relayMask = 0;
+    CHECK(rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0x01);
+
+    // The damaged slot is never reused; the next record goes after it
+    CHECK(journalAppend(0x04));
+    CHECK_EQ(journalSlot(0, 2)->relayMask, 0x04);
+    CHECK(rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0x04);
+}
+
+TEST(tornWriteIsSkipped) {
+    initJournal();
+    journalAppend(0x01);
+
+    // Power lost half way through the second record
+    JournalRecord* torn = journalSlot(0, 1);
+    torn->seq = 2;
+    uint8_t relayMask = 0;
+    CHECK(rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0x01);
+
+    journalAppend(0x06);
+    CHECK_EQ(journalSlot(0, 2)->relayMask, 0x06);
+}
+
+TEST(fullSectorCompactsIntoTheOther) {
+    initJournal();
+    for (uint32_t i = 0; i < RECORDS_PER_SECTOR; i++) {
+        journalAppend(i & 1 ? 0x01 : 0x02);
+    }
+    CHECK_EQ(hostFlashStats.sectorErases, 0u);
+
+    uint32_t compactions = journalStats.compactions;
+    journalAppend(0x0F);
+    CHECK_EQ(hostFlashStats.sectorErases, 1u);
+    CHECK_EQ(journalStats.compactions, compactions + 1);
+    CHECK_EQ(journalSlot(1, 0)->relayMask, 0x0F);
+    CHECK_EQ(journalSlot(1, 0)->seq, RECORDS_PER_SECTOR + 1);
+
+    // The old sector still holds lower sequence numbers; the scan must pick
+    // the newest record regardless of position
+    uint8_t relayMask = 0;
+    CHECK(rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0x0F);
+}
+
+TEST(wrapsBackToTheFirstSector) {
+    initJournal();
+    uint32_t toggles = RECORDS_PER_SECTOR * JOURNAL_SECTOR_COUNT + 10;
+    for (uint32_t i = 0; i < toggles; i++) {
+        journalAppend(i & 1 ? 0x01 : 0x02);
+    }
+    journalAppend(0x08);
+
+    uint8_t relayMask = 0;
+    CHECK(rebootAndRead(relayMask));
+    CHECK_EQ(relayMask, 0x08);
+    CHECK_EQ(hostFlashStats.sectorErases, (uint32_t)JOURNAL_SECTOR_COUNT);
+    CHECK_EQ(journalSlot(0, 0)->seq, RECORDS_PER_SECTOR * JOURNAL_SECTOR_COUNT + 1);
+}
+
+// The state path before the journal: every toggle rewrote the whole
+// DeviceConfig plus the per-relay bytes through EEPROM.commit()
+static void legacySaveDeviceState(uint8_t relayMask, uint8_t relayCount) {
+    LegacyDeviceConfig legacy;
+    memset(&legacy, 0, sizeof(legacy));
+    legacy.configVersion = LEGACY_CONFIG_VERSION;
+    legacy.relayCount = relayCount;
+    EEPROM.begin(sizeof(LegacyDeviceConfig) + relayCount);
+    EEPROM.put(CONFIG_ADDRESS, legacy);
+    for (uint8_t i = 0; i < relayCount; i++) {
+        EEPROM.write(CONFIG_ADDRESS + sizeof(LegacyDeviceConfig) + i, (relayMask >> i) & 1);
+    }
+    EEPROM.commit();
+    EEPROM.end();
+}
+
+struct PathCost {
+    uint32_t erases;
+    uint32_t bytesWritten;
+    double meanMicros;
+    uint64_t maxMicros;
+};
+
+template <typename Save>
+static PathCost measureToggles(uint32_t toggles, Save save) {
+    hostEraseFlash();
+    PathCost cost = {0, 0, 0, 0};
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < toggles; i++) {
+        uint64_t start = hostMicros();
+        save(i & 1 ? 0x01 : 0x00);
+        uint64_t elapsed = hostMicros() - start;
+        total += elapsed;
+        cost.maxMicros = max(cost.maxMicros, elapsed);
+    }
+    cost.erases = hostFlashStats.sectorErases;
+    cost.bytesWritten = hostFlashStats.bytesWritten;
+    cost.meanMicros = static_cast<double>(total) / toggles;
+    return cost;
+}
+
+BENCH(journalVersusSectorRewrite) {
+    const uint32_t toggles = 1000;
+
+    PathCost legacy = measureToggles(toggles, [](uint8_t relayMask) { legacySaveDeviceState(relayMask, 1); });
+    initJournal();
+    PathCost journal = measureToggles(toggles, [](uint8_t relayMask) { journalAppend(relayMask); });
+
+    REPORT("%u toggles, flash time from the simulated part's erase/program figures", toggles);
+    REPORT("legacy EEPROM commit: %u sector erases, %u bytes written, %.0f us mean, %.0f us max",
+           legacy.erases, legacy.bytesWritten, legacy.meanMicros, (double)legacy.maxMicros);
+    REPORT("journal append:       %u sector erases, %u bytes written, %.0f us mean, %.0f us max",
+           journal.erases, journal.bytesWritten, journal.meanMicros, (double)journal.maxMicros);
+
+    CHECK_EQ(legacy.erases, toggles);
+    CHECK(journal.erases <= toggles / RECORDS_PER_SECTOR + 1);
+    CHECK(journal.meanMicros * 50 < legacy.meanMicros);
+    CHECK_EQ(journal.bytesWritten, toggles * sizeof(JournalRecord));
+}
@@ -0,0 +1,133 @@
+// test_persistence.cpp
+#include "fixture.h"
+#include "journal.h"
+#include "webserver.h"
+
+static void setUp() {
+    static bool subscribed = false;
+    if (!subscribed) {
+        initDeviceEvents();
+        subscribed = true;
+    }
+    configureRelays(2);
+    initJournal();
+    flushPersistence();
+    persistenceStats = PersistenceStats();
+}
+
+static void toggleRelay() {
+    setRelayMask(0x01, getRelayMask() ^ 0x01);
+}
+
+TEST(stateCommitWaitsForQuietWindow) {
+    setUp();
+    toggleRelay();
+    runLoop(PERSIST_QUIET_WINDOW - 100);
+    CHECK_EQ(persistenceStats.stateCommits, 0u);
+
+    runLoop(200);
+    CHECK_EQ(persistenceStats.stateCommits, 1u);
+    uint8_t relayMask = 0;
+    initJournal();
+    CHECK(journalRead(relayMask));
+    CHECK_EQ(relayMask, 0x01);
+}
+
+TEST(burstCoalescesIntoOneCommit) {
+    setUp();
+    for (int i = 0; i < 10; i++) {
+        toggleRelay();
+        runLoop(100);
+    }
+    runLoop(PERSIST_QUIET_WINDOW + 100);
+    CHECK_EQ(persistenceStats.stateCommits, 1u);
+    CHECK_EQ(persistenceStats.commitsAvoided, 9u);
+}
+
+TEST(continuousTogglingFlushesAtMaxDelay) {
+    setUp();
+    uint64_t start = hostMicros();
+    while (persistenceStats.stateCommits == 0 && hostMicros() - start < 30000000ULL) {
+        toggleRelay();
+        runLoop(500);
+    }
+    uint64_t elapsedMs = (hostMicros() - start) / 1000;
+    CHECK_EQ(persistenceStats.stateCommits, 1u);
+    CHECK(elapsedMs >= PERSIST_MAX_DELAY);
+    CHECK(elapsedMs <= PERSIST_MAX_DELAY + 500);
+}
+
+TEST(configAndStateShareOneFlush) {
+    setUp();
+    uint32_t commits = EEPROM.commits;
+    saveConfig();
+    toggleRelay();
+    saveConfig();
+    runLoop(PERSIST_QUIET_WINDOW + 100);
+    CHECK_EQ(persistenceStats.configCommits, 1u);
+    CHECK_EQ(persistenceStats.stateCommits, 1u);
+    CHECK_EQ(EEPROM.commits, commits + 1);
+}
+
+TEST(restartFlushesPendingState) {
+    setUp();
+    toggleRelay();
+    runLoop(10);
+    uint32_t restarts = hostRestarts;
+    handleSetupMode();
+    runLoop(RESTART_DELAY + 50);
+
+    // Restarted inside the quiet window, with the toggle already on flash
+    CHECK_EQ(hostRestarts, restarts + 1);
+    CHECK_EQ(persistenceStats.stateCommits, 1u);
+    uint8_t relayMask = 0;
+    initJournal();
+    CHECK(journalRead(relayMask));
+    CHECK_EQ(relayMask, getRelayMask());
+}
+
+struct TogglePattern {
+    const char* name;
+    uint32_t burstLength; // Toggles per burst
+    uint32_t toggleGap;   // ms between toggles in a burst
+    uint32_t burstGap;    // ms between bursts
+};
+
+// Commits for 1000 toggles when every save commits at once (the old path)
+// and with the write-behind window
+static void runPattern(const TogglePattern& pattern, bool synchronous) {
+    setUp();
+    for (uint32_t toggle = 0; toggle < 1000; toggle++) {
+        toggleRelay();
+        dispatchEvents();
+        if (synchronous) {
+            flushPersistence();
+        }
+        bool endOfBurst = (toggle + 1) % pattern.burstLength == 0;
+        runLoop(endOfBurst ? pattern.burstGap : pattern.toggleGap);
+    }
+    runLoop(PERSIST_MAX_DELAY);
+}
+
+BENCH(commitsPer1000Toggles) {
+    static const TogglePattern patterns[] = {
+        {"bursts of 20, 150 ms apart, 30 s between", 20, 150, 30000},
+        {"one toggle every 5 s", 1, 5000, 5000},
+        {"one toggle every 300 ms, no pause", 1000, 300, 300},
+    };
+
+    for (const TogglePattern& pattern : patterns) {
+        runPattern(pattern, true);
+        uint32_t before = persistenceStats.stateCommits;
+        runPattern(pattern, false);
+        uint32_t after = persistenceStats.stateCommits;
+        REPORT("%-42s commit per save: %4u, write-behind: %4u (%u avoided)", pattern.name, before, after,
+               persistenceStats.commitsAvoided);
+
+        CHECK_EQ(before, 1000u);
+        CHECK(after <= before);
+        // At most one commit per quiet window or max delay, whichever comes first
+        uint64_t windows = 1000ULL * max(pattern.toggleGap, (uint32_t)PERSIST_QUIET_WINDOW) / PERSIST_QUIET_WINDOW;
+        CHECK(after <= windows);
+    }
+}
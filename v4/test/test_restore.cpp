@@ -0,0 +1,161 @@
+// test_restore.cpp
+#include "fixture.h"
+#include "journal.h"
+#include "rtc_state.h"
+
+#define RELAY_COUNT 3
+
+static void setUp() {
+    persistenceStats = PersistenceStats();
+    configureRelays(RELAY_COUNT);
+    initJournal();
+}
+
+// The relays as the last run left them, on the pins and in the journal
+static void runAndSave(uint8_t relayMask) {
+    setRelayMask((1 << RELAY_COUNT) - 1, relayMask);
+    saveDeviceState(deviceState);
+    flushPersistence();
+    dispatchEvents();
+}
+
+// Reset: pins float back to inputs, RAM and flash survive, RTC memory
+// only survives a warm reset. setup() runs from loadConfig() onwards.
+struct BootTrace {
+    uint32_t pinEvents;
+    uint32_t flashReads;
+};
+
+static BootTrace reboot(bool powerLoss) {
+    if (powerLoss) {
+        hostClearRtcMemory();
+    }
+    hostResetPins();
+    uint32_t reads = hostFlashStats.reads;
+
+    initRelayPins();
+    if (powerLoss) {
+        initJournal(); // What journalRead() does first after a real reset
+    }
+    loadDeviceState();
+
+    BootTrace trace;
+    trace.pinEvents = hostPinEvents().size();
+    trace.flashReads = hostFlashStats.reads - reads;
+    return trace;
+}
+
+// Every relay output is enabled with its level already latched, and the
+// level it is enabled with is the one it keeps
+static void checkNoGlitch(uint8_t relayMask) {
+    for (uint8_t i = 0; i < RELAY_COUNT; i++) {
+        uint8_t pin = config.relayPins[i];
+        uint8_t expected = relayMask & (1 << i) ? LOW : HIGH;
+        bool output = false;
+        uint8_t level = HIGH; // Pull-up while still an input
+        for (const HostPinEvent& event : hostPinEvents()) {
+            if (event.pin != pin) continue;
+            if (event.kind == HostPinEvent::MODE) {
+                CHECK_EQ(event.value, OUTPUT);
+                CHECK_EQ(level, expected);
+                output = true;
+            } else {
+                level = event.value;
+                CHECK(!output || level == expected);
+            }
+        }
+        CHECK(output);
+        CHECK_EQ(hostPinLevel(pin), expected);
+    }
+}
+
+TEST(warmRebootLatchesSavedLevels) {
+    setUp();
+    runAndSave(0x05);
+
+    BootTrace trace = reboot(false);
+    CHECK_EQ(getRelayMask(), 0x05);
+    checkNoGlitch(0x05);
+    CHECK_EQ(trace.flashReads, 0u);
+    REPORT("warm: %u pin events, %u flash reads to settle", trace.pinEvents, trace.flashReads);
+}
+
+TEST(warmRebootPrefersTheMirror) {
+    setUp();
+    runAndSave(0x06);
+    // A journal that disagrees shows which source was used
+    journalAppend(0x01);
+
+    reboot(false);
+    CHECK_EQ(getRelayMask(), 0x06);
+    checkNoGlitch(0x06);
+}
+
+TEST(coldBootStartsOffThenRestoresJournal) {
+    setUp();
+    runAndSave(0x03);
+
+    BootTrace trace = reboot(true);
+    CHECK_EQ(getRelayMask(), 0x03);
+    CHECK(trace.flashReads > 0);
+
+    // Outputs come up OFF; the journal state follows in the same boot
+    for (uint8_t i = 0; i < RELAY_COUNT; i++) {
+        uint8_t pin = config.relayPins[i];
+        bool sawOutput = false;
+        for (const HostPinEvent& event : hostPinEvents()) {
+            if (event.pin != pin) continue;
+            if (event.kind == HostPinEvent::MODE) {
+                sawOutput = true;
+            } else if (!sawOutput) {
+                CHECK_EQ(event.value, HIGH);
+            }
+        }
+        CHECK(sawOutput);
+    }
+    REPORT("cold: %u pin events, %u flash reads to settle", trace.pinEvents, trace.flashReads);
+}
+
+TEST(changedPinsIgnoreTheMirror) {
+    setUp();
+    runAndSave(0x07);
+    config.relayPins[2] = FIXTURE_FIRST_RELAY_PIN + RELAY_COUNT; // Rewired
+
+    hostResetPins();
+    initRelayPins();
+    for (uint8_t i = 0; i < RELAY_COUNT; i++) {
+        CHECK_EQ(hostPinLevel(config.relayPins[i]), HIGH);
+        CHECK_EQ(hostPinMode(config.relayPins[i]), OUTPUT);
+    }
+    uint8_t relayMask = 0;
+    CHECK(!readRtcRelayState(relayMask));
+}
+
+TEST(corruptMirrorIsIgnored) {
+    setUp();
+    runAndSave(0x07);
+    hostRtcMemory()[RTC_STATE_OFFSET * 4 + offsetof(RtcRelayState, relayMask)] ^= 0x02;
+
+    hostResetPins();
+    initRelayPins();
+    checkNoGlitch(0);
+    // The journal still has the last state
+    loadDeviceState();
+    CHECK_EQ(getRelayMask(), 0x07);
+}
+
+TEST(firstBootAfterMigrationUsesLegacyRelayBytes) {
+    setUp();
+    hostEraseFlash();
+    const uint8_t relayBytes[RELAY_COUNT] = {0, 1, 1};
+    memcpy(hostFlash() + HOST_EEPROM_SECTOR * SPI_FLASH_SEC_SIZE + CONFIG_ADDRESS + sizeof(LegacyDeviceConfig),
+           relayBytes, sizeof(relayBytes));
+    legacyConfigMigrated = true;
+
+    reboot(true);
+    legacyConfigMigrated = false;
+    CHECK_EQ(getRelayMask(), 0x06);
+    uint8_t relayMask = 0;
+    CHECK(journalRead(relayMask));
+    CHECK_EQ(relayMask, 0x06);
+}
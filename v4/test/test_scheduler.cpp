@@ -0,0 +1,163 @@
+// test_scheduler.cpp
+#include "test.h"
+#include "scheduler.h"
+#include <vector>
+
+static std::vector<uint32_t> runTimes;
+static TaskId selfCancellingTask = -1;
+
+static void recordRun() {
+    runTimes.push_back(millis());
+}
+
+static void cancelSelf() {
+    recordRun();
+    cancelTask(selfCancellingTask);
+}
+
+static void noop() {}
+
+// The task table outlives each case; start every case from an empty one
+static void setUp() {
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        cancelTask(i);
+    }
+    runTimes.clear();
+}
+
+// loop() passes step ms apart
+static void runFor(uint32_t duration, uint32_t step) {
+    for (uint32_t elapsed = 0; elapsed < duration; elapsed += step) {
+        runScheduler();
+        hostAdvanceMillis(step);
+    }
+}
+
+TEST(periodicTaskKeepsItsPhase) {
+    setUp();
+    TaskId id = scheduleEvery("tick", 100, recordRun, 100);
+    runFor(1000, 7); // Passes that never line up with the interval
+
+    CHECK_EQ(runTimes.size(), 9u);
+    for (size_t i = 0; i < runTimes.size(); i++) {
+        uint32_t due = 100 * (i + 1);
+        CHECK(runTimes[i] >= due && runTimes[i] < due + 7);
+    }
+    CHECK_EQ(getTask(id)->missedDeadlines, 0u);
+}
+
+TEST(lateRunKeepsPhaseWithinOneInterval) {
+    setUp();
+    TaskId id = scheduleEvery("tick", 100, recordRun, 100);
+    hostAdvanceMillis(180);
+    runScheduler();
+    CHECK_EQ(getTask(id)->due, 200u);
+    CHECK_EQ(getTask(id)->missedDeadlines, 0u);
+}
+
+TEST(fullIntervalLateCountsAMissAndRestartsFromNow) {
+    setUp();
+    TaskId id = scheduleEvery("tick", 100, recordRun, 100);
+    hostAdvanceMillis(350); // A long blocking call elsewhere in loop()
+    runScheduler();
+    runScheduler();
+    CHECK_EQ(runTimes.size(), 1u); // No back-to-back catch-up runs
+    CHECK_EQ(getTask(id)->missedDeadlines, 1u);
+    CHECK_EQ(getTask(id)->due, 450u);
+}
+
+TEST(periodicTaskSurvivesMillisRollover) {
+    setUp();
+    // 250 ms before millis() wraps
+    hostSetMicros((0x100000000ULL - 250) * 1000);
+    TaskId id = scheduleEvery("tick", 100, recordRun, 100);
+    runFor(1000, 10);
+
+    CHECK_EQ(runTimes.size(), 9u);
+    CHECK_EQ(getTask(id)->missedDeadlines, 0u);
+    // Evenly spaced across the wrap
+    for (size_t i = 1; i < runTimes.size(); i++) {
+        CHECK_EQ(runTimes[i] - runTimes[i - 1], 100u);
+    }
+    CHECK(runTimes.front() > 0x80000000u);
+    CHECK(runTimes.back() < 1000u);
+}
+
+TEST(oneShotAcrossRolloverWaitsItsDelay) {
+    setUp();
+    hostSetMicros((0x100000000ULL - 200) * 1000);
+    uint64_t start = hostMicros();
+    scheduleOnce("later", 500, recordRun);
+    runFor(499, 1);
+    CHECK_EQ(runTimes.size(), 0u);
+    runFor(2, 1);
+    CHECK_EQ(runTimes.size(), 1u);
+    CHECK_EQ(hostMicros() - start, 501000u);
+}
+
+TEST(oneShotSlackDecidesAMiss) {
+    setUp();
+    TaskId onTime = scheduleOnce("onTime", 100, recordRun);
+    hostAdvanceMillis(100 + SCHEDULER_ONESHOT_SLACK - 1);
+    runScheduler();
+    CHECK_EQ(getTask(onTime)->missedDeadlines, 0u);
+    CHECK(!getTask(onTime)->active);
+
+    TaskId late = scheduleOnce("late", 100, recordRun);
+    hostAdvanceMillis(100 + SCHEDULER_ONESHOT_SLACK);
+    runScheduler();
+    CHECK_EQ(getTask(late)->missedDeadlines, 1u);
+    CHECK_EQ(runTimes.size(), 2u);
+}
+
+TEST(taskMayCancelItself) {
+    setUp();
+    selfCancellingTask = scheduleEvery("once", 50, cancelSelf, 50);
+    runFor(500, 10);
+    CHECK_EQ(runTimes.size(), 1u);
+    CHECK(!getTask(selfCancellingTask)->active);
+}
+
+TEST(zeroIntervalRunsEveryPass) {
+    setUp();
+    scheduleEvery("busy", 0, recordRun);
+    runFor(100, 10);
+    CHECK_EQ(runTimes.size(), 10u);
+}
+
+TEST(fullTableRefusesAndReusesFreedSlots) {
+    setUp();
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        CHECK(scheduleEvery("filler", 1000, noop) >= 0);
+    }
+    CHECK_EQ(scheduleOnce("extra", 10, recordRun), -1);
+    CHECK(hostSerialOutput().find("Scheduler full, dropping task extra") != std::string::npos);
+
+    cancelTask(3);
+    CHECK_EQ(scheduleOnce("extra", 10, recordRun), 3);
+    runFor(20, 10);
+    CHECK_EQ(runTimes.size(), 1u);
+    // A fired one-shot frees its slot too
+    CHECK_EQ(scheduleOnce("again", 10, recordRun), 3);
+}
+
+BENCH(schedulerPassOverhead) {
+    setUp();
+    // The boot task set: nothing due on most passes
+    static const uint32_t intervals[] = {20, 100, 10, 10, 5000, 60000, 100, 300000, 1000, 5000};
+    for (uint32_t interval : intervals) {
+        scheduleEvery("boot", interval, noop, interval);
+    }
+    hostSetMicros(1000);
+    double idle = nanosPerCall(1000000, [](uint32_t i) { runScheduler(); });
+
+    // One pass per simulated millisecond, so tasks fall due at their rates
+    double busy = nanosPerCall(100000, [](uint32_t i) {
+        hostAdvanceMillis(1);
+        runScheduler();
+    });
+
+    REPORT("%u tasks in %u slots: %.0f ns per pass with nothing due, %.0f ns per 1 ms pass at boot rates (host)",
+           (unsigned)(sizeof(intervals) / sizeof(intervals[0])), SCHEDULER_MAX_TASKS, idle, busy);
+    CHECK(idle < 1000);
+}
@@ -0,0 +1,241 @@
+// test_ws_protocol.cpp
+#include "fixture.h"
+#include "sensors.h"
+#include "snapshot.h"
+#include "json_writer.h"
+#include "commands.h"
+#include <ArduinoJson.h>
+
+#define JSON_CLIENT 0
+#define BINARY_CLIENT 1
+
+static volatile size_t benchSink; // Keeps the measured encoders from being optimized out
+
+static void setUp() {
+    static bool subscribed = false;
+    if (!subscribed) {
+        initDeviceEvents();
+        subscribed = true;
+    }
+    startWebServer();
+    configureRelays(4);
+    config.sensorCount = 3;
+    config.sensors[0] = SensorConfig{SENSOR_DHT, 4, 22, 0, false, 0, SENSOR_DEFAULT_FILTER};
+    config.sensors[1] = SensorConfig{SENSOR_LDR, 17, 0, 0, false, 0, SENSOR_DEFAULT_FILTER};
+    config.sensors[2] = SensorConfig{SENSOR_SOIL, 17, 0, 0, false, 0, SENSOR_DEFAULT_FILTER};
+    memset(sensorData, 0, sizeof(sensorData));
+    sensorData[0].temperature = 21.4f;
+    sensorData[0].humidity = 48.25f;
+    sensorData[1].light = 73.0f;
+    sensorData[2].moisture = 35.6f;
+    setRelayMask(0x0F, 0x05);
+    dispatchEvents();
+}
+
+static uint16_t readU16(const std::string& frame, size_t pos) {
+    return static_cast<uint8_t>(frame[pos]) | (static_cast<uint8_t>(frame[pos + 1]) << 8);
+}
+
+TEST(relayStateFrameLayout) {
+    uint8_t frame[WS_FRAME_MAX_SIZE];
+    CHECK_EQ(wsEncodeRelayState(frame, 0x1234, 4, 0x0A), 5u);
+    CHECK_EQ(frame[0], WS_OP_RELAY_STATE);
+    CHECK_EQ(frame[1], 0x34);
+    CHECK_EQ(frame[2], 0x12);
+    CHECK_EQ(frame[3], 4);
+    CHECK_EQ(frame[4], 0x0A);
+
+    WsFrameHeader header;
+    CHECK(wsDecodeHeader(frame, 5, header));
+    CHECK_EQ(header.opcode, WS_OP_RELAY_STATE);
+    CHECK_EQ(header.seq, 0x1234);
+    CHECK(!wsDecodeHeader(frame, WS_FRAME_HEADER_SIZE - 1, header));
+}
+
+TEST(sensorValuesAreSignedTenths) {
+    uint8_t frame[WS_FRAME_MAX_SIZE];
+    const float values[] = {-3.26f, NAN};
+    size_t length = wsEncodeSensor(frame, 1, 2, SENSOR_DHT, values, 2);
+    CHECK_EQ(length, (size_t)WS_FRAME_HEADER_SIZE + WS_SENSOR_ENTRY_MAX_SIZE);
+    CHECK_EQ(frame[3], 2);
+    CHECK_EQ(frame[4], SENSOR_DHT);
+    CHECK_EQ(frame[5], 2);
+    CHECK_EQ(static_cast<int16_t>(frame[6] | (frame[7] << 8)), -33);
+    CHECK_EQ(static_cast<int16_t>(frame[8] | (frame[9] << 8)), INT16_MIN); // No reading
+}
+
+TEST(handshakeChoosesTheFormat) {
+    setUp();
+    CHECK(webSocket.hostConnect(JSON_CLIENT) != nullptr);
+    CHECK(webSocket.hostConnect(BINARY_CLIENT, "chat, " WS_BINARY_PROTOCOL) != nullptr);
+    CHECK(webSocket.hostConnect(2, "chat") == nullptr);
+    CHECK(!wsClientBinary[JSON_CLIENT]);
+    CHECK(wsClientBinary[BINARY_CLIENT]);
+
+    // Both start from a snapshot in their own format
+    CHECK(!webSocket.hostSent[JSON_CLIENT][0].binary);
+    CHECK(webSocket.hostSent[JSON_CLIENT][0].payload.find("\"type\":\"snapshot\"") != std::string::npos);
+    CHECK(webSocket.hostSent[BINARY_CLIENT][0].binary);
+    CHECK_EQ(static_cast<uint8_t>(webSocket.hostSent[BINARY_CLIENT][0].payload[0]), WS_OP_SNAPSHOT);
+}
+
+TEST(binaryRelayCommandIsAcknowledged) {
+    setUp();
+    webSocket.hostConnect(BINARY_CLIENT, WS_BINARY_PROTOCOL);
+    webSocket.hostSent[BINARY_CLIENT].clear();
+
+    const uint8_t command[] = {WS_OP_RELAY_SET, 77, 0, 1, 1};
+    webSocket.hostReceive(BINARY_CLIENT, true, command, sizeof(command));
+    dispatchEvents();
+    CHECK_EQ(getRelayMask(), 0x07);
+
+    bool acked = false;
+    for (const HostWsMessage& message : webSocket.hostSent[BINARY_CLIENT]) {
+        if (message.binary && static_cast<uint8_t>(message.payload[0]) == WS_OP_ACK) {
+            CHECK_EQ(readU16(message.payload, 1), 77);
+            CHECK_EQ(message.payload[3], 1);
+            acked = true;
+        }
+    }
+    CHECK(acked);
+
+    // A retry with the same seq is answered, not applied again
+    uint32_t applied = commandStats.applied;
+    webSocket.hostReceive(BINARY_CLIENT, true, command, sizeof(command));
+    CHECK_EQ(commandStats.applied, applied);
+    CHECK_EQ(commandStats.duplicates, 1u);
+}
+
+TEST(broadcastReachesEachClientInItsFormat) {
+    setUp();
+    webSocket.hostConnect(JSON_CLIENT);
+    webSocket.hostConnect(BINARY_CLIENT, WS_BINARY_PROTOCOL);
+    webSocket.hostSent[JSON_CLIENT].clear();
+    webSocket.hostSent[BINARY_CLIENT].clear();
+
+    setRelayMask(0x02, 0x02);
+    dispatchEvents();
+    CHECK_EQ(webSocket.hostSent[JSON_CLIENT].size(), 1u);
+    CHECK(webSocket.hostSent[JSON_CLIENT][0].payload.find("\"type\":\"relay\",\"index\":1,\"state\":true") == 1);
+    CHECK_EQ(webSocket.hostSent[BINARY_CLIENT].size(), 1u);
+    const std::string& frame = webSocket.hostSent[BINARY_CLIENT][0].payload;
+    CHECK_EQ(static_cast<uint8_t>(frame[0]), WS_OP_RELAY_STATE);
+    CHECK_EQ(static_cast<uint8_t>(frame[4]), 0x07);
+}
+
+struct MessageCost {
+    size_t jsonBytes;
+    size_t binaryBytes;
+    double jsonNanos;
+    double binaryNanos;
+};
+
+static void reportCost(const char* name, const MessageCost& cost) {
+    REPORT("%-8s json %3u bytes %6.0f ns   binary %3u bytes %5.0f ns   %.1fx smaller", name,
+           (unsigned)cost.jsonBytes, cost.jsonNanos, (unsigned)cost.binaryBytes, cost.binaryNanos,
+           (double)cost.jsonBytes / cost.binaryBytes);
+}
+
+// Payload plus the unmasked server frame header it goes out with
+static size_t wireBytes(size_t payloadLength) {
+    return payloadLength + (payloadLength < 126 ? 2 : 4);
+}
+
+static size_t lastSentBytes(uint8_t num) {
+    return wireBytes(webSocket.hostSent[num].back().payload.size());
+}
+
+BENCH(binaryVersusJsonEncoding) {
+    setUp();
+    webSocket.hostConnect(JSON_CLIENT);
+    webSocket.hostConnect(BINARY_CLIENT, WS_BINARY_PROTOCOL);
+    const uint32_t iterations = 200000;
+    MessageCost relay, sensor, snapshot;
+
+    // Relay state, as broadcastRelayStates() builds it for four relays
+    broadcastRelayStates(0x0F, wsNextSeq());
+    relay.jsonBytes = lastSentBytes(JSON_CLIENT);
+    relay.binaryBytes = lastSentBytes(BINARY_CLIENT);
+    relay.jsonNanos = nanosPerCall(iterations, [](uint32_t i) {
+        JsonWriter json(messageBuffer, sizeof(messageBuffer));
+        json.beginObject().add("type", "relays").beginArray("states");
+        for (int relay = 0; relay < 4; relay++) {
+            json.add(((i >> relay) & 1) != 0);
+        }
+        json.endArray().add("version", static_cast<unsigned long>(i)).endObject();
+        benchSink = json.length();
+    });
+    relay.binaryNanos = nanosPerCall(iterations, [](uint32_t i) {
+        uint8_t frame[WS_FRAME_MAX_SIZE];
+        benchSink = wsEncodeRelayState(frame, i, 4, i & 0x0F);
+    });
+
+    // One DHT reading
+    broadcastSensorData(0);
+    sensor.jsonBytes = lastSentBytes(JSON_CLIENT);
+    sensor.binaryBytes = lastSentBytes(BINARY_CLIENT);
+    sensor.jsonNanos = nanosPerCall(iterations, [](uint32_t i) {
+        float values[] = {21.4f + (i & 7), 48.2f};
+        JsonWriter json(messageBuffer, sizeof(messageBuffer));
+        json.beginObject().add("sensor", 0).add("type", static_cast<int>(SENSOR_DHT));
+        writeSensorValues(json, SENSOR_DHT, values);
+        json.endObject();
+        benchSink = json.length();
+    });
+    sensor.binaryNanos = nanosPerCall(iterations, [](uint32_t i) {
+        float values[] = {21.4f + (i & 7), 48.2f};
+        uint8_t frame[WS_FRAME_MAX_SIZE];
+        benchSink = wsEncodeSensor(frame, i, 0, SENSOR_DHT, values, 2);
+    });
+
+    // The snapshot every new client gets
+    snapshot.jsonBytes = wireBytes(sendSnapshot(JSON_CLIENT));
+    snapshot.binaryBytes = wireBytes(sendSnapshot(BINARY_CLIENT));
+    snapshot.jsonNanos = nanosPerCall(iterations / 4, [](uint32_t i) {
+        JsonWriter json(messageBuffer, sizeof(messageBuffer));
+        writeSnapshotJson(json);
+        benchSink = json.length();
+    });
+    snapshot.binaryNanos = nanosPerCall(iterations / 4, [](uint32_t i) {
+        uint8_t frame[WS_SNAPSHOT_FRAME_MAX_SIZE];
+        benchSink = encodeSnapshotFrame(frame, i);
+    });
+
+    REPORT("encode cost is host CPU time; bytes include the WebSocket frame header");
+    reportCost("relays", relay);
+    reportCost("sensor", sensor);
+    reportCost("snapshot", snapshot);
+
+    CHECK(relay.binaryBytes * 4 < relay.jsonBytes);
+    CHECK(sensor.binaryBytes * 3 < sensor.jsonBytes);
+    CHECK(snapshot.binaryBytes * 3 < snapshot.jsonBytes);
+    CHECK(relay.binaryNanos < relay.jsonNanos);
+    CHECK(sensor.binaryNanos < sensor.jsonNanos);
+    CHECK(snapshot.binaryNanos < snapshot.jsonNanos);
+}
+
+BENCH(binaryVersusJsonCommandDecoding) {
+    const char* text = "{\"type\":\"relay\",\"index\":1,\"state\":true,\"id\":4242}";
+    const uint8_t frame[] = {WS_OP_RELAY_SET, 0x92, 0x10, 1, 1};
+    const uint32_t iterations = 200000;
+
+    // The host ArduinoJson is a flat-object stand-in, not the library, so
+    // this understates what the device spends on the JSON side
+    double jsonNanos = nanosPerCall(iterations, [text](uint32_t i) {
+        StaticJsonDocument<512> doc;
+        deserializeJson(doc, text);
+        const char* type = doc["type"];
+        int index = doc["index"];
+        bool state = doc["state"];
+        benchSink = (type != nullptr) + index + state;
+    });
+    double binaryNanos = nanosPerCall(iterations, [&frame](uint32_t i) {
+        WsFrameHeader header;
+        wsDecodeHeader(frame, sizeof(frame), header);
+        benchSink = header.opcode + frame[3] + frame[4];
+    });
+
+    REPORT("relay command: json %u bytes %.0f ns (host parser stand-in)   binary %u bytes %.0f ns",
+           (unsigned)strlen(text), jsonNanos, (unsigned)sizeof(frame), binaryNanos);
+    CHECK(binaryNanos < jsonNanos);
+}
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Minify and gzip the pages in code/UI.h into code/UI_gz.h.
+
+Run after editing UI.h:
+
+    python3 v4/tools/build_ui.py
+
+Every PROGMEM raw-string page in UI.h becomes a gzipped PROGMEM byte array
+plus a strong ETag derived from the minified content, which the web server
+sends with Content-Encoding: gzip and answers with 304 when it matches.
+"""
+import gzip
+import hashlib
+import os
+import re
+
+CODE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "code")
+SOURCE = os.path.join(CODE_DIR, "UI.h")
+OUTPUT = os.path.join(CODE_DIR, "UI_gz.h")
+
+PAGE_RE = re.compile(r'const char (\w+)\[\] PROGMEM = R"rawliteral\((.*?)\)rawliteral";', re.S)
+
+
+def minify(html):
+    # Conservative: drop HTML comments, indentation and blank lines, but keep
+    # line breaks so inline JavaScript relying on them stays valid
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    lines = (line.strip() for line in html.splitlines())
+    return "\n".join(line for line in lines if line)
+
+
+def c_array(data):
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(rows)
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        source = f.read()
+
+    out = [
+        "// UI_gz.h",
+        "// Generated by tools/build_ui.py from UI.h - do not edit",
+        "#ifndef UI_GZ_H",
+        "#define UI_GZ_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+
+    for name, page in PAGE_RE.findall(source):
+        body = minify(page).encode("utf-8")
+        packed = gzip.compress(body, compresslevel=9, mtime=0)
+        etag = hashlib.sha1(body).hexdigest()[:16]
+        print("%s: %d -> %d bytes minified -> %d bytes gzipped" % (name, len(page.encode("utf-8")), len(body), len(packed)))
+
+        out.append('#define %s_GZ_ETAG "\\"%s\\""' % (name, etag))
+        out.append("const uint8_t %s_GZ[] PROGMEM = {" % name)
+        out.append(c_array(packed))
+        out.append("};")
+        out.append("")
+
+    out.append("#endif")
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()